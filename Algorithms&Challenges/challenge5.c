@@ -1,6 +1,9 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <time.h>
+
+#include "sort.h"
+
 #define MAX_NUMBER 100
 
 void insertion_sort(int vec[], int size){
@@ -147,6 +150,17 @@ int main(int argc, char const *argv[]) {
   }
   printf("O Número de erros é: %d\n", wrong_n);
   wrong_n = 0;
+// ---------------------------------------------
+  printf("%s\n", "Introsort/Radix Sort:");
+  for (int i = 0; i < times; i++) {
+    generate_vector(vec,size);
+    sort(vec,size);
+    if(!is_sequence(vec,size)){
+      wrong_n++;
+    }
+  }
+  printf("O Número de erros é: %d\n", wrong_n);
+  wrong_n = 0;
 
   return 0;
 }
@@ -0,0 +1,202 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "sort.h"
+
+#define INSERTION_CUTOFF 16
+/*Elementos por passada do radix a partir dos quais ele vence o introsort.*/
+#define RADIX_MIN_SIZE 256
+
+static void swap(int vec[], int a, int b){
+  int temp = vec[a];
+  vec[a] = vec[b];
+  vec[b] = temp;
+}
+
+static void insertion_sort_range(int vec[], int low, int high){
+  /*Ordena vec[low..high] (inclusive) sem recursão.*/
+  for (int j = low + 1; j <= high; j++) {
+    int temp = vec[j];
+    int i = j - 1;
+    while (i >= low && vec[i] > temp) {
+      vec[i + 1] = vec[i];
+      i--;
+    }
+    vec[i + 1] = temp;
+  }
+}
+
+static void sift_down(int vec[], int root, int size){
+  /*Desce vec[root] até que os dois filhos sejam menores ou iguais.*/
+  int temp = vec[root];
+  int child;
+  while ((child = 2 * root + 1) < size) {
+    if(child + 1 < size && vec[child + 1] > vec[child]){
+      child++;
+    }
+    if(vec[child] <= temp){
+      break;
+    }
+    vec[root] = vec[child];
+    root = child;
+  }
+  vec[root] = temp;
+}
+
+void heap_sort(int vec[], int size){
+  for (int i = size / 2 - 1; i >= 0; i--) {
+    sift_down(vec, i, size);
+  }
+  for (int end = size - 1; end > 0; end--) {
+    //O maior fica no topo do heap: vai para o fim da parte desordenada.
+    swap(vec, 0, end);
+    sift_down(vec, 0, end);
+  }
+}
+
+static int median_of_three(int vec[], int low, int high){
+  int mid = low + (high - low) / 2;
+  if(vec[mid] < vec[low]){
+    swap(vec, mid, low);
+  }
+  if(vec[high] < vec[low]){
+    swap(vec, high, low);
+  }
+  if(vec[high] < vec[mid]){
+    swap(vec, high, mid);
+  }
+  return vec[mid];
+}
+
+static void introsort_range(int vec[], int low, int high, int depth_limit){
+  while (high - low + 1 > INSERTION_CUTOFF) {
+    if(depth_limit-- == 0){
+      /*Partições ruins demais: o heapsort garante O(n log n) no resto.*/
+      heap_sort(vec + low, high - low + 1);
+      return;
+    }
+    int pivot = median_of_three(vec, low, high);
+    /*Partição de Hoare: valores iguais ao pivô se dividem entre os dois
+      lados, então vetores com muitas repetições não degeneram.*/
+    int i = low - 1;
+    int j = high + 1;
+    for (;;) {
+      do {
+        i++;
+      } while (vec[i] < pivot);
+      do {
+        j--;
+      } while (vec[j] > pivot);
+      if(i >= j){
+        break;
+      }
+      swap(vec, i, j);
+    }
+    /*Recursão só na parte menor e laço na maior: a pilha fica em O(log n).*/
+    if(j - low < high - j){
+      introsort_range(vec, low, j, depth_limit);
+      low = j + 1;
+    }else{
+      introsort_range(vec, j + 1, high, depth_limit);
+      high = j;
+    }
+  }
+  insertion_sort_range(vec, low, high);
+}
+
+void introsort(int vec[], int size){
+  int depth_limit = 0;
+  for (int n = size; n > 1; n >>= 1) {
+    depth_limit += 2;
+  }
+  if(size > 1){
+    introsort_range(vec, 0, size - 1, depth_limit);
+  }
+}
+
+/*Ordena pelas chaves (vec[i] - min) usando passes bytes, do menos para o
+  mais significativo. Devolve 0 se não houver memória para o auxiliar.*/
+static int radix_sort_keys(int vec[], int size, int min, int passes){
+  int *buffer = malloc(size * sizeof(int));
+  if(buffer == NULL){
+    return 0;
+  }
+  int *from = vec;
+  int *to = buffer;
+  for (int pass = 0; pass < passes; pass++) {
+    int shift = pass * 8;
+    int count[257];
+    memset(count, 0, sizeof(count));
+    for (int i = 0; i < size; i++) {
+      unsigned key = (unsigned)from[i] - (unsigned)min;
+      count[((key >> shift) & 0xff) + 1]++;
+    }
+    for (int d = 0; d < 256; d++) {
+      //Transforma as contagens na primeira posição de cada dígito.
+      count[d + 1] += count[d];
+    }
+    for (int i = 0; i < size; i++) {
+      unsigned key = (unsigned)from[i] - (unsigned)min;
+      to[count[(key >> shift) & 0xff]++] = from[i];
+    }
+    int *temp = from;
+    from = to;
+    to = temp;
+  }
+  if(from != vec){
+    memcpy(vec, from, size * sizeof(int));
+  }
+  free(buffer);
+  return 1;
+}
+
+/*Quantos bytes a maior chave (max - min) ocupa.*/
+static int key_bytes(int min, int max){
+  unsigned range = (unsigned)max - (unsigned)min;
+  int passes = 0;
+  while (range > 0) {
+    passes++;
+    range >>= 8;
+  }
+  return passes;
+}
+
+static void find_range(int vec[], int size, int *min, int *max){
+  *min = vec[0];
+  *max = vec[0];
+  for (int i = 1; i < size; i++) {
+    if(vec[i] < *min){
+      *min = vec[i];
+    }else if(vec[i] > *max){
+      *max = vec[i];
+    }
+  }
+}
+
+void radix_sort(int vec[], int size){
+  if(size < 2){
+    return;
+  }
+  int min, max;
+  find_range(vec, size, &min, &max);
+  if(!radix_sort_keys(vec, size, min, key_bytes(min, max))){
+    introsort(vec, size);
+  }
+}
+
+void sort(int vec[], int size){
+  if(size < RADIX_MIN_SIZE){
+    introsort(vec, size);
+    return;
+  }
+  int min, max;
+  find_range(vec, size, &min, &max);
+  int passes = key_bytes(min, max);
+  /*Cada passada custa duas leituras e uma escrita por elemento; quanto
+    menor o intervalo dos valores, menos passadas e menor o vetor em que o
+    radix já compensa.*/
+  if(size >= RADIX_MIN_SIZE * passes && radix_sort_keys(vec, size, min, passes)){
+    return;
+  }
+  introsort(vec, size);
+}
@@ -0,0 +1,20 @@
+#ifndef SORT_H
+#define SORT_H
+
+/*Ordena vec em ordem crescente escolhendo o algoritmo pelo tamanho do
+  vetor e pelo intervalo dos valores: radix sort quando ele compensa,
+  introsort nos demais casos.*/
+void sort(int vec[], int size);
+
+/*Quicksort com mediana de três, que passa para heapsort quando a
+  recursão fica funda demais e para insertion sort nos trechos pequenos.
+  O(n log n) no pior caso, sem memória extra.*/
+void introsort(int vec[], int size);
+
+void heap_sort(int vec[], int size);
+
+/*Radix sort LSD por bytes, estável, O(n) por passada. Usa um vetor
+  auxiliar de size inteiros; sem memória, recorre ao introsort.*/
+void radix_sort(int vec[], int size);
+
+#endif
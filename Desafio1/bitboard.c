@@ -0,0 +1,105 @@
+#include "bitboard.h"
+
+#define NOT_COL_0 0xfefefefefefefefeULL
+#define NOT_COL_7 0x7f7f7f7f7f7f7f7fULL
+
+// Moves every stone one step in a direction; shift > 0 towards higher
+// squares. mask drops stones that wrapped around to the other side.
+static inline bitboard step(bitboard b, int shift, bitboard mask) {
+  return (shift > 0 ? b << shift : b >> -shift) & mask;
+}
+
+// Kogge-Stone occluded fill: gen plus every square reachable from it
+// by stepping over pro only. Three doubling rounds cover the 6 stones
+// a run can be long.
+static inline bitboard fill(bitboard gen, bitboard pro, int shift, bitboard mask) {
+  pro &= mask;
+  gen |= pro & step(gen, shift, ~0ULL);
+  pro &= step(pro, shift, ~0ULL);
+  gen |= pro & step(gen, 2 * shift, ~0ULL);
+  pro &= step(pro, 2 * shift, ~0ULL);
+  gen |= pro & step(gen, 4 * shift, ~0ULL);
+  return gen;
+}
+
+static inline bitboard moves_in(bitboard own, bitboard opp, bitboard empty, int shift, bitboard mask) {
+  return step(fill(own, opp, shift, mask) & opp, shift, mask) & empty;
+}
+
+static inline bitboard flips_in(bitboard own, bitboard opp, bitboard move, int shift, bitboard mask) {
+  bitboard run = fill(move, opp, shift, mask) & opp;
+  return step(run | move, shift, mask) & own ? run : 0;
+}
+
+void bitboard_from_board(int player, int board[8][8], bitboard *own, bitboard *opp) {
+  *own = 0;
+  *opp = 0;
+  for (int i = 0; i < 8; i++) {
+    for (int j = 0; j < 8; j++) {
+      if(board[i][j] == player){
+        *own |= SQUARE_BIT(SQUARE(i, j));
+      }else if(board[i][j] != -1){
+        *opp |= SQUARE_BIT(SQUARE(i, j));
+      }
+    }
+  }
+}
+
+int bitboard_parse(const char *text, int *player, bitboard *own, bitboard *opp) {
+  bitboard stones[2] = {0, 0};
+  int square = 0;
+  for (; *text != '\0'; text++) {
+    char c = *text;
+    if(c == ' ' || c == '\t' || c == '\n' || c == '\r'){
+      continue;
+    }
+    int color = c == 'X' ? 0 : c == 'O' ? 1 : c == '-' ? -1 : -2;
+    if(color == -2){
+      return 0;
+    }
+    if(square == 64){
+      if(color == -1){
+        return 0;
+      }
+      *player = color;
+      *own = stones[color];
+      *opp = stones[1 - color];
+      square++;
+    }else if(square > 64){
+      return 0;
+    }else{
+      if(color >= 0){
+        stones[color] |= SQUARE_BIT(square);
+      }
+      square++;
+    }
+  }
+  return square == 65;
+}
+
+bitboard bitboard_moves(bitboard own, bitboard opp) {
+  bitboard empty = ~(own | opp);
+  return moves_in(own, opp, empty, 1, NOT_COL_0)
+       | moves_in(own, opp, empty, -1, NOT_COL_7)
+       | moves_in(own, opp, empty, 8, ~0ULL)
+       | moves_in(own, opp, empty, -8, ~0ULL)
+       | moves_in(own, opp, empty, 9, NOT_COL_0)
+       | moves_in(own, opp, empty, -9, NOT_COL_7)
+       | moves_in(own, opp, empty, 7, NOT_COL_7)
+       | moves_in(own, opp, empty, -7, NOT_COL_0);
+}
+
+bitboard bitboard_flips(bitboard own, bitboard opp, int square) {
+  bitboard move = SQUARE_BIT(square);
+  if((own | opp) & move){
+    return 0;
+  }
+  return flips_in(own, opp, move, 1, NOT_COL_0)
+       | flips_in(own, opp, move, -1, NOT_COL_7)
+       | flips_in(own, opp, move, 8, ~0ULL)
+       | flips_in(own, opp, move, -8, ~0ULL)
+       | flips_in(own, opp, move, 9, NOT_COL_0)
+       | flips_in(own, opp, move, -9, NOT_COL_7)
+       | flips_in(own, opp, move, 7, NOT_COL_7)
+       | flips_in(own, opp, move, -7, NOT_COL_0);
+}
@@ -0,0 +1,42 @@
+#ifndef BITBOARD_H
+#define BITBOARD_H
+
+#include <stdint.h>
+
+// One bit per square, bit row*8+col set when the square is occupied.
+// A position is two of these: the stones of the side to move and the
+// stones of its opponent.
+typedef uint64_t bitboard;
+
+#define SQUARE(row, col) ((row) * 8 + (col))
+#define SQUARE_ROW(square) ((square) >> 3)
+#define SQUARE_COL(square) ((square) & 7)
+#define SQUARE_BIT(square) ((bitboard)1 << (square))
+
+// Converts the int board[8][8] used by play() (0/1 players, -1 empty).
+void bitboard_from_board(int player, int board[8][8], bitboard *own, bitboard *opp);
+
+// Reads a position written row by row as 64 of 'X' (player 0), 'O'
+// (player 1) and '-', then the player to move. Whitespace is skipped.
+// Returns 0 if text is not such a position.
+int bitboard_parse(const char *text, int *player, bitboard *own, bitboard *opp);
+
+// The opening position in that notation, laid out as in reversi.c.
+#define BITBOARD_START "---------------------------XO------OX--------------------------- O"
+
+// Every empty square where own may play, all eight directions at once.
+bitboard bitboard_moves(bitboard own, bitboard opp);
+
+// Opponent stones turned over when own plays at square; 0 if illegal.
+bitboard bitboard_flips(bitboard own, bitboard opp, int square);
+
+static inline int bitboard_count(bitboard b) {
+  return __builtin_popcountll(b);
+}
+
+// Lowest set square; b must not be 0.
+static inline int bitboard_first(bitboard b) {
+  return __builtin_ctzll(b);
+}
+
+#endif
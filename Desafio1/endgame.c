@@ -0,0 +1,358 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <time.h>
+
+#include "endgame.h"
+
+// Below this many empties moves are tried in parity order straight off
+// the empty list; at or above it they are sorted fastest-first.
+#define FASTEST_FIRST_EMPTIES 6
+// Positions with at least this many empties go through the hash table.
+#define HASH_EMPTIES 8
+// Nodes between two looks at the clock.
+#define CLOCK_INTERVAL 4095
+
+// Board quadrant of a square, 0 to 3.
+#define QUADRANT(square) ((((square) >> 5) & 1) << 1 | (((square) >> 2) & 1))
+
+static double now(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static endgame_entry *table_slot(const endgame_solver *solver, bitboard own, bitboard opp) {
+  uint64_t key = (own ^ (opp * 0x9e3779b97f4a7c15ULL)) * 0xff51afd7ed558ccdULL;
+  return &solver->table[(key >> 32 ^ key) & solver->table_mask];
+}
+
+static int disc_difference(bitboard own, bitboard opp) {
+  return bitboard_count(own) - bitboard_count(opp);
+}
+
+// One empty square left: whoever can play there does, or nobody can.
+static int solve_1(endgame_solver *solver, bitboard own, bitboard opp, int x) {
+  solver->nodes++;
+  bitboard flips = bitboard_flips(own, opp, x);
+  if(flips){
+    int turned = bitboard_count(flips);
+    return bitboard_count(own) + turned + 1 - (bitboard_count(opp) - turned);
+  }
+  flips = bitboard_flips(opp, own, x);
+  if(flips){
+    int turned = bitboard_count(flips);
+    return bitboard_count(own) - turned - (bitboard_count(opp) + turned + 1);
+  }
+  return disc_difference(own, opp);
+}
+
+static int solve_2(endgame_solver *solver, bitboard own, bitboard opp, int alpha, int beta,
+                   int x1, int x2, int passed) {
+  solver->nodes++;
+  int best = -64;
+  int legal = 0;
+  bitboard flips = bitboard_flips(own, opp, x1);
+  if(flips){
+    legal = 1;
+    best = -solve_1(solver, opp ^ flips, own | flips | SQUARE_BIT(x1), x2);
+    if(best >= beta){
+      return best;
+    }
+  }
+  flips = bitboard_flips(own, opp, x2);
+  if(flips){
+    legal = 1;
+    int score = -solve_1(solver, opp ^ flips, own | flips | SQUARE_BIT(x2), x1);
+    if(score > best){
+      best = score;
+    }
+  }
+  if(!legal){
+    if(passed){
+      return disc_difference(own, opp);
+    }
+    return -solve_2(solver, opp, own, -beta, -alpha, x1, x2, 1);
+  }
+  return best;
+}
+
+static int solve_3(endgame_solver *solver, bitboard own, bitboard opp, int alpha, int beta,
+                   int x1, int x2, int x3, int passed) {
+  solver->nodes++;
+  int squares[3] = {x1, x2, x3};
+  int best = -64;
+  int legal = 0;
+  for (int i = 0; i < 3; i++) {
+    int x = squares[i];
+    bitboard flips = bitboard_flips(own, opp, x);
+    if(!flips){
+      continue;
+    }
+    legal = 1;
+    int score = -solve_2(solver, opp ^ flips, own | flips | SQUARE_BIT(x), -beta,
+                         -(alpha > best ? alpha : best), squares[(i + 1) % 3], squares[(i + 2) % 3], 0);
+    if(score > best){
+      best = score;
+      if(best >= beta){
+        return best;
+      }
+    }
+  }
+  if(!legal){
+    if(passed){
+      return disc_difference(own, opp);
+    }
+    return -solve_3(solver, opp, own, -beta, -alpha, x1, x2, x3, 1);
+  }
+  return best;
+}
+
+static int solve_4(endgame_solver *solver, bitboard own, bitboard opp, int alpha, int beta,
+                   const int x[4], int passed) {
+  solver->nodes++;
+  int best = -64;
+  int legal = 0;
+  for (int i = 0; i < 4; i++) {
+    bitboard flips = bitboard_flips(own, opp, x[i]);
+    if(!flips){
+      continue;
+    }
+    legal = 1;
+    int rest[3];
+    for (int j = 0, k = 0; j < 4; j++) {
+      if(j != i){
+        rest[k++] = x[j];
+      }
+    }
+    int score = -solve_3(solver, opp ^ flips, own | flips | SQUARE_BIT(x[i]), -beta,
+                         -(alpha > best ? alpha : best), rest[0], rest[1], rest[2], 0);
+    if(score > best){
+      best = score;
+      if(best >= beta){
+        return best;
+      }
+    }
+  }
+  if(!legal){
+    if(passed){
+      return disc_difference(own, opp);
+    }
+    return -solve_4(solver, opp, own, -beta, -alpha, x, 1);
+  }
+  return best;
+}
+
+// Copies the empty list without square.
+static void remove_square(const int *empties, int n, int square, int *rest) {
+  for (int i = 0, k = 0; i < n; i++) {
+    if(empties[i] != square){
+      rest[k++] = empties[i];
+    }
+  }
+}
+
+// Moves that leave an odd number of empties in their quadrant come
+// first: whoever plays last in a region tends to keep it.
+static void order_by_parity(const int *empties, int n, int *ordered) {
+  unsigned parity = 0;
+  for (int i = 0; i < n; i++) {
+    parity ^= 1u << QUADRANT(empties[i]);
+  }
+  int k = 0;
+  for (int i = 0; i < n; i++) {
+    if(parity & (1u << QUADRANT(empties[i]))){
+      ordered[k++] = empties[i];
+    }
+  }
+  for (int i = 0; i < n; i++) {
+    if(!(parity & (1u << QUADRANT(empties[i])))){
+      ordered[k++] = empties[i];
+    }
+  }
+}
+
+// Sorts the legal moves so the opponent's reply count is smallest
+// first, parity breaking ties. Returns how many there are.
+static int order_fastest_first(bitboard own, bitboard opp, const int *empties, int n, int *list) {
+  unsigned parity = 0;
+  for (int i = 0; i < n; i++) {
+    parity ^= 1u << QUADRANT(empties[i]);
+  }
+  int keys[64];
+  int count = 0;
+  for (bitboard moves = bitboard_moves(own, opp); moves; moves &= moves - 1) {
+    int square = bitboard_first(moves);
+    bitboard flips = bitboard_flips(own, opp, square);
+    int replies = bitboard_count(bitboard_moves(opp ^ flips, own | flips | SQUARE_BIT(square)));
+    int key = replies * 2 + !(parity & (1u << QUADRANT(square)));
+    int i = count++;
+    while (i > 0 && keys[i - 1] > key) {
+      keys[i] = keys[i - 1];
+      list[i] = list[i - 1];
+      i--;
+    }
+    keys[i] = key;
+    list[i] = square;
+  }
+  return count;
+}
+
+static int solve(endgame_solver *solver, bitboard own, bitboard opp, int alpha, int beta,
+                 const int *empties, int n, int passed) {
+  if(n == 4){
+    int ordered[4];
+    order_by_parity(empties, 4, ordered);
+    return solve_4(solver, own, opp, alpha, beta, ordered, passed);
+  }else if(n == 3){
+    return solve_3(solver, own, opp, alpha, beta, empties[0], empties[1], empties[2], passed);
+  }else if(n == 2){
+    return solve_2(solver, own, opp, alpha, beta, empties[0], empties[1], passed);
+  }else if(n == 1){
+    return solve_1(solver, own, opp, empties[0]);
+  }else if(n == 0){
+    return disc_difference(own, opp);
+  }
+
+  solver->nodes++;
+  if(solver->deadline > 0 && (solver->nodes & CLOCK_INTERVAL) == 0 && now() > solver->deadline){
+    solver->stop = 1;
+  }
+  if(solver->stop){
+    return 0;
+  }
+  endgame_entry *entry = NULL;
+  int first = -1;
+  if(solver->table != NULL && n >= HASH_EMPTIES){
+    entry = table_slot(solver, own, opp);
+    if(entry->own == own && entry->opp == opp){
+      if(entry->lower >= beta || entry->lower == entry->upper){
+        return entry->lower;
+      }
+      if(entry->upper <= alpha){
+        return entry->upper;
+      }
+      if(entry->lower > alpha){
+        alpha = entry->lower;
+      }
+      if(entry->upper < beta){
+        beta = entry->upper;
+      }
+      first = entry->move;
+    }
+  }
+  int original_alpha = alpha;
+  int list[64];
+  int count;
+  if(n < FASTEST_FIRST_EMPTIES){
+    order_by_parity(empties, n, list);
+    count = n;
+  }else{
+    count = order_fastest_first(own, opp, empties, n, list);
+  }
+  for (int i = 1; i < count; i++) {
+    if(list[i] == first){
+      list[i] = list[0];
+      list[0] = first;
+    }
+  }
+
+  int best = -64;
+  int best_square = -1;
+  int legal = 0;
+  int rest[64];
+  for (int i = 0; i < count; i++) {
+    int square = list[i];
+    bitboard flips = bitboard_flips(own, opp, square);
+    if(!flips){
+      continue;
+    }
+    remove_square(empties, n, square, rest);
+    bitboard child_own = opp ^ flips;
+    bitboard child_opp = own | flips | SQUARE_BIT(square);
+    int floor = alpha > best ? alpha : best;
+    int score;
+    if(!legal){
+      score = -solve(solver, child_own, child_opp, -beta, -floor, rest, n - 1, 0);
+    }else{
+      // Later moves only have to prove they are no better than the best.
+      score = -solve(solver, child_own, child_opp, -floor - 1, -floor, rest, n - 1, 0);
+      if(score > floor && score < beta){
+        score = -solve(solver, child_own, child_opp, -beta, -score, rest, n - 1, 0);
+      }
+    }
+    legal = 1;
+    if(solver->stop){
+      return 0;
+    }
+    if(score > best){
+      best = score;
+      best_square = square;
+      if(best >= beta){
+        break;
+      }
+    }
+  }
+  if(!legal){
+    if(passed){
+      return disc_difference(own, opp);
+    }
+    return -solve(solver, opp, own, -beta, -alpha, empties, n, 1);
+  }
+  if(entry != NULL){
+    entry->own = own;
+    entry->opp = opp;
+    entry->lower = best > original_alpha ? best : -64;
+    entry->upper = best < beta ? best : 64;
+    entry->move = best_square;
+  }
+  return best;
+}
+
+static int list_empties(bitboard own, bitboard opp, int *empties) {
+  int n = 0;
+  for (bitboard b = ~(own | opp); b; b &= b - 1) {
+    empties[n++] = bitboard_first(b);
+  }
+  return n;
+}
+
+int endgame_solve(endgame_solver *solver, bitboard own, bitboard opp, int alpha, int beta) {
+  int empties[64];
+  int n = list_empties(own, opp, empties);
+  return solve(solver, own, opp, alpha, beta, empties, n, 0);
+}
+
+int endgame_best_move(endgame_solver *solver, bitboard own, bitboard opp, int *score) {
+  int empties[64];
+  int n = list_empties(own, opp, empties);
+  int list[64];
+  int count = order_fastest_first(own, opp, empties, n, list);
+  int rest[64];
+  int best = -65;
+  int best_square = -1;
+  for (int i = 0; i < count; i++) {
+    int square = list[i];
+    bitboard flips = bitboard_flips(own, opp, square);
+    remove_square(empties, n, square, rest);
+    bitboard child_own = opp ^ flips;
+    bitboard child_opp = own | flips | SQUARE_BIT(square);
+    int value;
+    if(i == 0){
+      value = -solve(solver, child_own, child_opp, -64, 64, rest, n - 1, 0);
+    }else{
+      value = -solve(solver, child_own, child_opp, -best - 1, -best, rest, n - 1, 0);
+      if(value > best){
+        value = -solve(solver, child_own, child_opp, -64, -value, rest, n - 1, 0);
+      }
+    }
+    if(solver->stop){
+      return -1;
+    }
+    if(value > best){
+      best = value;
+      best_square = square;
+    }
+  }
+  *score = best;
+  return best_square;
+}
@@ -0,0 +1,39 @@
+#ifndef ENDGAME_H
+#define ENDGAME_H
+
+#include <stddef.h>
+
+#include "bitboard.h"
+
+// Empty squares at which play() stops estimating and starts solving.
+#define ENDGAME_EMPTIES 20
+
+// Bounds proven for one position with many empties left.
+typedef struct endgame_entry {
+  bitboard own;
+  bitboard opp;
+  signed char lower;
+  signed char upper;
+  unsigned char move;
+} endgame_entry;
+
+// Counters, limits and the optional hash table for exact solves. The
+// solver allocates nothing itself: table belongs to the caller, holds
+// table_mask + 1 entries and may be NULL.
+typedef struct endgame_solver {
+  endgame_entry *table;
+  size_t table_mask;
+  long long nodes;
+  double deadline; // 0 means no time limit
+  int stop;
+} endgame_solver;
+
+// Final disc difference (own minus opp) under perfect play, with
+// fail-soft alpha-beta bounds. Meaningless once solver->stop is set.
+int endgame_solve(endgame_solver *solver, bitboard own, bitboard opp, int alpha, int beta);
+
+// Best move for own and its exact disc difference in *score; -1 when
+// own has to pass or the deadline ran out first (solver->stop).
+int endgame_best_move(endgame_solver *solver, bitboard own, bitboard opp, int *score);
+
+#endif
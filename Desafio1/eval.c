@@ -0,0 +1,207 @@
+#include <stdlib.h>
+
+#include "eval.h"
+
+// Every square's weight is shared out among the patterns covering it;
+// a square lies in 1 to 5 of them, so scaling by 60 keeps shares exact.
+#define EVAL_SCALE 60
+// Per disc that can no longer be turned over along an edge.
+#define STABLE_WEIGHT 10
+
+static int power3(int n) {
+  int p = 1;
+  while (n-- > 0) {
+    p *= 3;
+  }
+  return p;
+}
+
+static void add_cell(eval_tables *tables, int pattern, int row, int col) {
+  tables->cells[pattern][tables->size[pattern]++] = SQUARE(row, col);
+}
+
+// Lays out which squares each pattern reads, in digit order.
+static void build_patterns(eval_tables *tables) {
+  int p = 0;
+  for (int i = 0; i < 8; i++, p++) {
+    tables->size[p] = 0;
+    for (int j = 0; j < 8; j++) {
+      add_cell(tables, p, i, j);
+    }
+  }
+  for (int j = 0; j < 8; j++, p++) {
+    tables->size[p] = 0;
+    for (int i = 0; i < 8; i++) {
+      add_cell(tables, p, i, j);
+    }
+  }
+  // Diagonals of 3 or more squares: col - row and row + col constant.
+  for (int d = -5; d <= 5; d++, p++) {
+    tables->size[p] = 0;
+    for (int i = 0; i < 8; i++) {
+      if(i + d >= 0 && i + d < 8){
+        add_cell(tables, p, i, i + d);
+      }
+    }
+  }
+  for (int s = 2; s <= 12; s++, p++) {
+    tables->size[p] = 0;
+    for (int i = 0; i < 8; i++) {
+      if(s - i >= 0 && s - i < 8){
+        add_cell(tables, p, i, s - i);
+      }
+    }
+  }
+  // Corner regions, corner first and mirrored so they all read alike.
+  for (int corner = 0; corner < 4; corner++, p++) {
+    int row = corner & 2 ? 7 : 0;
+    int col = corner & 1 ? 7 : 0;
+    int dr = row ? -1 : 1;
+    int dc = col ? -1 : 1;
+    tables->size[p] = 0;
+    for (int i = 0; i < 3; i++) {
+      for (int j = 0; j < 3; j++) {
+        add_cell(tables, p, row + i * dr, col + j * dc);
+      }
+    }
+  }
+
+  for (int square = 0; square < 64; square++) {
+    tables->membership_count[square] = 0;
+  }
+  for (p = 0; p < EVAL_PATTERNS; p++) {
+    for (int i = 0; i < tables->size[p]; i++) {
+      int square = tables->cells[p][i];
+      eval_membership *m = &tables->memberships[square][tables->membership_count[square]++];
+      m->pattern = p;
+      m->place = power3(i);
+    }
+  }
+}
+
+static int sign(int cell) {
+  return cell == CELL_X ? 1 : cell == CELL_O ? -1 : 0;
+}
+
+// Discs that runs from an occupied corner (or a full edge) make safe.
+static int edge_stability(const int *cell) {
+  int full = 1;
+  for (int i = 0; i < 8; i++) {
+    if(cell[i] == CELL_EMPTY){
+      full = 0;
+    }
+  }
+  int score = 0;
+  if(full){
+    for (int i = 0; i < 8; i++) {
+      score += sign(cell[i]);
+    }
+    return score;
+  }
+  for (int i = 0; i < 8 && cell[i] == cell[0] && cell[0] != CELL_EMPTY; i++) {
+    score += sign(cell[i]);
+  }
+  for (int i = 7; i >= 0 && cell[i] == cell[7] && cell[7] != CELL_EMPTY; i--) {
+    score += sign(cell[i]);
+  }
+  return score;
+}
+
+// Score of one pattern configuration, scaled by EVAL_SCALE.
+static int pattern_score(const eval_tables *tables, int pattern, const int *cell, const int weights[8][8]) {
+  int score = 0;
+  for (int i = 0; i < tables->size[pattern]; i++) {
+    int square = tables->cells[pattern][i];
+    int weight = weights[SQUARE_ROW(square)][SQUARE_COL(square)];
+    score += sign(cell[i]) * weight * (EVAL_SCALE / tables->membership_count[square]);
+  }
+  int is_edge = pattern == 0 || pattern == 7 || pattern == 8 || pattern == 15;
+  if(is_edge){
+    score += edge_stability(cell) * STABLE_WEIGHT * EVAL_SCALE;
+  }
+  // Once the corner is taken, the squares next to it stop being the
+  // liability their weights assume.
+  if(pattern >= EVAL_PATTERNS - 4 && cell[0] != CELL_EMPTY){
+    static const int next_to_corner[3] = {1, 3, 4};
+    for (int k = 0; k < 3; k++) {
+      int i = next_to_corner[k];
+      int square = tables->cells[pattern][i];
+      score -= sign(cell[i]) * weights[SQUARE_ROW(square)][SQUARE_COL(square)] * EVAL_SCALE;
+    }
+  }
+  return score;
+}
+
+int eval_init(eval_tables *tables, const int weights[8][8]) {
+  build_patterns(tables);
+  for (int p = 0; p < EVAL_PATTERNS; p++) {
+    tables->scores[p] = NULL;
+  }
+  for (int p = 0; p < EVAL_PATTERNS; p++) {
+    int count = power3(tables->size[p]);
+    tables->scores[p] = malloc(count * sizeof(int));
+    if(tables->scores[p] == NULL){
+      eval_free(tables);
+      return 0;
+    }
+    int cell[EVAL_MAX_CELLS];
+    for (int index = 0; index < count; index++) {
+      for (int i = 0, rest = index; i < tables->size[p]; i++, rest /= 3) {
+        cell[i] = rest % 3;
+      }
+      tables->scores[p][index] = pattern_score(tables, p, cell, weights);
+    }
+  }
+  return 1;
+}
+
+void eval_free(eval_tables *tables) {
+  for (int p = 0; p < EVAL_PATTERNS; p++) {
+    free(tables->scores[p]);
+    tables->scores[p] = NULL;
+  }
+}
+
+void eval_set(const eval_tables *tables, eval_state *state, bitboard x, bitboard o) {
+  for (int p = 0; p < EVAL_PATTERNS; p++) {
+    int index = 0;
+    for (int i = tables->size[p] - 1; i >= 0; i--) {
+      bitboard bit = SQUARE_BIT(tables->cells[p][i]);
+      index = index * 3 + (x & bit ? CELL_X : o & bit ? CELL_O : CELL_EMPTY);
+    }
+    state->index[p] = index;
+  }
+}
+
+// Adds delta times the square's digit weight to every pattern it is in.
+static inline void shift_square(const eval_tables *tables, eval_state *state, int square, int delta) {
+  const eval_membership *m = tables->memberships[square];
+  for (int i = 0; i < tables->membership_count[square]; i++) {
+    state->index[m[i].pattern] += delta * m[i].place;
+  }
+}
+
+void eval_play(const eval_tables *tables, eval_state *state, int color, int square, bitboard flips) {
+  // A flip turns O (2) into X (1) or back: one digit step.
+  int flip_delta = color == 0 ? -1 : 1;
+  shift_square(tables, state, square, color == 0 ? CELL_X : CELL_O);
+  for (; flips; flips &= flips - 1) {
+    shift_square(tables, state, bitboard_first(flips), flip_delta);
+  }
+}
+
+void eval_undo(const eval_tables *tables, eval_state *state, int color, int square, bitboard flips) {
+  int flip_delta = color == 0 ? 1 : -1;
+  shift_square(tables, state, square, color == 0 ? -CELL_X : -CELL_O);
+  for (; flips; flips &= flips - 1) {
+    shift_square(tables, state, bitboard_first(flips), flip_delta);
+  }
+}
+
+int eval_score(const eval_tables *tables, const eval_state *state) {
+  int score = 0;
+  for (int p = 0; p < EVAL_PATTERNS; p++) {
+    score += tables->scores[p][state->index[p]];
+  }
+  return score / EVAL_SCALE;
+}
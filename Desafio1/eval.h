@@ -0,0 +1,54 @@
+#ifndef EVAL_H
+#define EVAL_H
+
+#include <stdint.h>
+
+#include "bitboard.h"
+
+// 8 rows, 8 columns, the 22 diagonals of 3 or more squares and the
+// four 3x3 corner regions.
+#define EVAL_PATTERNS 42
+#define EVAL_MAX_CELLS 9
+// Patterns any one square belongs to, at most.
+#define EVAL_MAX_MEMBERSHIPS 5
+
+// Square states in a pattern index: each cell is one base-3 digit.
+#define CELL_EMPTY 0
+#define CELL_X 1
+#define CELL_O 2
+
+typedef struct eval_membership {
+  unsigned char pattern;
+  unsigned short place; // 3 to the cell's digit position
+} eval_membership;
+
+// Score tables for every pattern, built once per engine from its square
+// weights. scores[p][index] is from X's (player 0's) point of view.
+typedef struct eval_tables {
+  int cells[EVAL_PATTERNS][EVAL_MAX_CELLS];
+  int size[EVAL_PATTERNS];
+  int *scores[EVAL_PATTERNS];
+  eval_membership memberships[64][EVAL_MAX_MEMBERSHIPS];
+  int membership_count[64];
+} eval_tables;
+
+// The current index of every pattern, kept up to date move by move.
+typedef struct eval_state {
+  uint16_t index[EVAL_PATTERNS];
+} eval_state;
+
+// Returns 0 if out of memory.
+int eval_init(eval_tables *tables, const int weights[8][8]);
+void eval_free(eval_tables *tables);
+
+// Recomputes every index from scratch.
+void eval_set(const eval_tables *tables, eval_state *state, bitboard x, bitboard o);
+
+// color (0 for X) plays square and turns flips over, or takes it back.
+void eval_play(const eval_tables *tables, eval_state *state, int color, int square, bitboard flips);
+void eval_undo(const eval_tables *tables, eval_state *state, int color, int square, bitboard flips);
+
+// Table lookups summed, from X's point of view, in weights units.
+int eval_score(const eval_tables *tables, const eval_state *state);
+
+#endif
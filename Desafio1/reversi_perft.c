@@ -0,0 +1,140 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "bitboard.h"
+
+// Leaf counts from the opening position, a pass counting as one move
+// and a finished game as one leaf.
+static const long long start_counts[] = {
+  1, 4, 12, 56, 244, 1396, 8200, 55092, 390216, 3005288, 24571284,
+  212258800, 1939886636, 18429641748LL, 184042084512LL
+};
+#define START_DEPTHS ((int)(sizeof(start_counts) / sizeof(start_counts[0])))
+
+typedef struct bench_position {
+  const char *position;
+  int depth;
+  long long leaves;
+} bench_position;
+
+// Fixed midgame positions for --bench, reached by random play; the
+// counts were checked against a square-by-square move generator.
+static const bench_position bench[] = {
+  {"---XOO-O--OOOOO-XXOOOXO--OOOOO---O-OOO-------OX------OX------OX- X", 7, 28691116},
+  {"-----------XO-----X-OO---XXXOX---XXXX------XO------OO-----O-O--- O", 7, 20118647},
+  {"-----XOX----XOX----XOXX--OOOX----XOOXO--X-X-O--------O---------- X", 7, 20775866},
+  {"--XO-X--XXXOOO--XOOX-O-OOOXXXOO-O-XOXOX--XXXOOX--O-OXO-X-----X-- O", 7, 19124077},
+  {"--X-X-X--OOOOXX-O-X-X-X-XOXXXXXXXOOXXXX-XOXXXXO--OXX-X----X----- O", 7, 10001203},
+  {"----------OOX-O----OXXOO--XOXOO--X-OXO-XXXXOO------O------------ X", 7, 47030968},
+  {"O--------O--XO----O-X-----OOX-X----OOX---XXOXXX---OXXOO--OOX--OO X", 7, 27100893},
+  {"--X-O-X--O-XXXXX-OO-X-X-OOOOXXX-OOOOX-X-OOOOX-XO----X----------- O", 7, 3701671}
+};
+#define BENCH_POSITIONS ((int)(sizeof(bench) / sizeof(bench[0])))
+
+static double now(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static long long perft(bitboard own, bitboard opp, int depth, int passed) {
+  if(depth == 0){
+    return 1;
+  }
+  bitboard moves = bitboard_moves(own, opp);
+  if(!moves){
+    if(passed){
+      return 1;
+    }
+    return perft(opp, own, depth - 1, 1);
+  }
+  if(depth == 1){
+    return bitboard_count(moves);
+  }
+  long long leaves = 0;
+  for (; moves; moves &= moves - 1) {
+    int square = bitboard_first(moves);
+    bitboard flips = bitboard_flips(own, opp, square);
+    leaves += perft(opp ^ flips, own | flips | SQUARE_BIT(square), depth - 1, 0);
+  }
+  return leaves;
+}
+
+// Counts one position to depth and reports the speed; returns 0 when
+// expected is known (non-zero) and the count differs.
+static int run(const char *label, bitboard own, bitboard opp, int depth, long long expected, long long *total, double *seconds) {
+  double start = now();
+  long long leaves = perft(own, opp, depth, 0);
+  double elapsed = now() - start;
+  *total += leaves;
+  *seconds += elapsed;
+  printf("%s depth %d: %lld leaves in %.3f s, %.0f leaves/s", label, depth, leaves, elapsed,
+         elapsed > 0 ? leaves / elapsed : 0);
+  if(expected == 0){
+    printf("\n");
+    return 1;
+  }else if(leaves != expected){
+    printf("  MISMATCH, expected %lld\n", expected);
+    return 0;
+  }
+  printf("  ok\n");
+  return 1;
+}
+
+static void usage(const char *program) {
+  fprintf(stderr, "usage: %s [--depth N] [--bench] [position]\n", program);
+}
+
+int main(int argc, char const *argv[]) {
+  const char *position = BITBOARD_START;
+  int depth = 9;
+  int run_bench = 0;
+  for (int i = 1; i < argc; i++) {
+    if(strcmp(argv[i], "--depth") == 0 && i + 1 < argc){
+      depth = atoi(argv[++i]);
+    }else if(strcmp(argv[i], "--bench") == 0){
+      run_bench = 1;
+    }else if(strncmp(argv[i], "--", 2) == 0 && strlen(argv[i]) < 64){
+      // Longer arguments are positions, which may start with empty squares.
+      usage(argv[0]);
+      return 1;
+    }else{
+      position = argv[i];
+    }
+  }
+
+  int ok = 1;
+  long long total = 0;
+  double seconds = 0;
+  if(run_bench){
+    for (int i = 0; i < BENCH_POSITIONS; i++) {
+      int player;
+      bitboard own, opp;
+      bitboard_parse(bench[i].position, &player, &own, &opp);
+      char label[32];
+      sprintf(label, "position %d", i + 1);
+      ok &= run(label, own, opp, bench[i].depth, bench[i].leaves, &total, &seconds);
+    }
+  }else{
+    int player;
+    bitboard own, opp, start_own, start_opp;
+    if(!bitboard_parse(position, &player, &own, &opp)){
+      fprintf(stderr, "not a position: %s\n", position);
+      return 1;
+    }
+    bitboard_parse(BITBOARD_START, &player, &start_own, &start_opp);
+    // Known counts only apply to the opening; with the other color to
+    // move it is a mirror image of it, which counts the same.
+    int opening = (own == start_own && opp == start_opp) || (own == start_opp && opp == start_own);
+    for (int d = 1; d <= depth; d++) {
+      long long expected = opening && d < START_DEPTHS ? start_counts[d] : 0;
+      ok &= run("perft", own, opp, d, expected, &total, &seconds);
+    }
+  }
+  printf("total %lld leaves in %.3f s, %.0f leaves/s\n", total, seconds, seconds > 0 ? total / seconds : 0);
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,74 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "bitboard.h"
+#include "search.h"
+
+static const int weights[8][8]={{120,-20, 20,  5,  5, 20,-20,120},
+                                {-20,-40, -5, -5, -5, -5,-40,-20},
+                                { 20, -5, 15,  3,  3, 15, -5, 20},
+                                {  5, -5,  3,  3,  3,  3, -5,  5},
+                                {  5, -5,  3,  3,  3,  3, -5,  5},
+                                { 20, -5, 15,  3,  3, 15, -5, 20},
+                                {-20,-40, -5, -5, -5, -5,-40,-20},
+                                {120,-20, 20,  5,  5, 20,-20,120}};
+
+static void usage(const char *program) {
+  fprintf(stderr, "usage: %s [--threads N] [--time SECONDS] [--depth N] [--table MB] [--endgame EMPTIES] [position]\n", program);
+}
+
+// Searches one position and reports the move with the search speed, so
+// runs with different --threads show how the engine scales.
+int main(int argc, char const *argv[]) {
+  const char *position = BITBOARD_START;
+  int threads = 1;
+  double seconds = 10;
+  int depth = 60;
+  long table_mb = 64;
+  int endgame = ENDGAME_EMPTIES;
+  for (int i = 1; i < argc; i++) {
+    if(strcmp(argv[i], "--threads") == 0 && i + 1 < argc){
+      threads = atoi(argv[++i]);
+    }else if(strcmp(argv[i], "--time") == 0 && i + 1 < argc){
+      seconds = atof(argv[++i]);
+    }else if(strcmp(argv[i], "--depth") == 0 && i + 1 < argc){
+      depth = atoi(argv[++i]);
+    }else if(strcmp(argv[i], "--table") == 0 && i + 1 < argc){
+      table_mb = atol(argv[++i]);
+    }else if(strcmp(argv[i], "--endgame") == 0 && i + 1 < argc){
+      endgame = atoi(argv[++i]);
+    }else if(strncmp(argv[i], "--", 2) == 0 && strlen(argv[i]) < 64){
+      // Longer arguments are positions, which may start with empty squares.
+      usage(argv[0]);
+      return 1;
+    }else{
+      position = argv[i];
+    }
+  }
+
+  int player;
+  bitboard own, opp;
+  if(!bitboard_parse(position, &player, &own, &opp)){
+    fprintf(stderr, "not a position: %s\n", position);
+    return 1;
+  }
+  search_engine engine;
+  if(!search_engine_init(&engine, (size_t)table_mb << 20, weights)){
+    fprintf(stderr, "out of memory\n");
+    return 1;
+  }
+  engine.threads = threads;
+  engine.endgame_empties = endgame;
+  search_result result;
+  int square = search_move(&engine, player, own, opp, depth, seconds, &result);
+  if(square == -1){
+    printf("pass\n");
+  }else{
+    printf("move %d,%d score %d depth %d\n", SQUARE_ROW(square), SQUARE_COL(square), result.score, result.depth);
+  }
+  printf("%lld nodes in %.3f s, %.0f nodes/s with %d threads\n",
+         result.nodes, result.seconds, result.nodes_per_second, threads);
+  search_engine_free(&engine);
+  return 0;
+}
@@ -2,10 +2,12 @@
 #include <stdlib.h>
 #include <limits.h>
 
+#include "bitboard.h"
+
 
 int opponent(int player);
 int play(int player, int board[8][8], int *p_row, int *p_col);
- check_sum_probs(int player, int board[8][8], int x, int y);
+int check_sum_probs(bitboard flips);
 
                   // 0   1   2   3   4   5   6   7
 int weights[8][8]={{120,-20, 20,  5,  5, 20,-20,120},//0
@@ -19,78 +21,33 @@ int weights[8][8]={{120,-20, 20,  5,  5, 20,-20,120},//0
 
 int play(int player, int board[8][8], int *p_row, int *p_col) {
 
-  int opp = opponent(player);
+  bitboard own, opp;
+  bitboard_from_board(player, board, &own, &opp);
+  bitboard moves = bitboard_moves(own, opp);
   int prob = INT_MIN;
   int found = 0;
-  for (int i = 0; i < 8; i++) {
-    for (int j = 0; j < 8; j++) {
-      if (board[i][j] == player) {
-        int x = i;
-        int y = j;
-        for (int k = -1; k <= 1; k++) {
-          for (int l = -1; l <= 1; l++) {
-            int new_x = x+l;
-            int new_y = y+k;
-            int val_dir = 0;
-            while(new_x >= 0 && new_x < 8 && new_y >= 0 && new_y < 8){
-              int pos = board[new_x][new_y];
-              if(pos == player || (val_dir == 0 && pos == -1)){
-                val_dir = 0;
-                break;
-              }
-              else if(pos == opp){
-                new_x += l;
-                new_y += k;
-                val_dir = 1;
-              }
-              else if(val_dir == 1 && pos == -1){
-                int new_prob = check_sum_probs(player, board, new_x, new_y);
-                //int new_prob = weights[new_x][new_y];
-                if(new_prob > prob){
-                  prob = new_prob;
-                  *p_row = new_x;
-                  *p_col = new_y;
-                  found = 1;
-                }
-                break;
-              }
-            }
-          }
-        }
-      }
+  while(moves){
+    int square = bitboard_first(moves);
+    moves &= moves - 1;
+    int new_prob = check_sum_probs(bitboard_flips(own, opp, square));
+    //int new_prob = weights[SQUARE_ROW(square)][SQUARE_COL(square)];
+    if(new_prob > prob){
+      prob = new_prob;
+      *p_row = SQUARE_ROW(square);
+      *p_col = SQUARE_COL(square);
+      found = 1;
     }
   }
   return found;
 }
 
-int check_sum_probs(int player,int board[8][8], int x, int y){
-  int opp = opponent(player);
+// Sum of the weights of the stones a move turns over.
+int check_sum_probs(bitboard flips){
   int new_prob = 0;
-  int prob_count = 0;
-  for (int k = -1; k <= 1; k++) {
-    for (int l = -1; l <= 1; l++) {
-      int new_x = x+l;
-      int new_y = y+k;
-      int val_dir = 0;
-      while(new_x >= 0 && new_x < 8 && new_y >= 0 && new_y < 8){
-        int pos = board[new_x][new_y];
-        if(pos == -1 || (val_dir == 0 && pos == player)){
-          val_dir = 0;
-          break;
-        }
-        else if(pos == opp){
-          new_x += l;
-          new_y += k;
-          prob_count += weights[new_x][new_y];
-          val_dir = 1;
-        }
-        else if(val_dir == 1 && pos == player){
-          new_prob += prob_count;
-          prob_count = 0;
-          break;
-        }
-      }
-    }
+  while(flips){
+    int square = bitboard_first(flips);
+    flips &= flips - 1;
+    new_prob += weights[SQUARE_ROW(square)][SQUARE_COL(square)];
   }
   return new_prob;
 }
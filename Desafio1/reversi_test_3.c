@@ -1,11 +1,24 @@
+#define _POSIX_C_SOURCE 200809L
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <limits.h>
+#include <unistd.h>
+
+#include "bitboard.h"
+#include "search.h"
+
+// Per-move budget for play().
+#define PLAY_SECONDS 1.0
+#define PLAY_MAX_DEPTH 60
+#define PLAY_TABLE_BYTES (16 << 20)
+// Lazy SMP stops paying much beyond this many threads.
+#define PLAY_MAX_THREADS 8
 
 
 int opponent(int player);
 int play(int player, int board[8][8], int *p_row, int *p_col);
- check_sum_probs(int player, int board[8][8], int x, int y);
+int check_sum_probs(int player, int board[8][8], int x, int y);
 
                   // 0   1   2   3   4   5   6   7
 int weights[8][8]={{120,-20, 20,  5,  5, 20,-20,120},//0
@@ -17,61 +30,52 @@ int weights[8][8]={{120,-20, 20,  5,  5, 20,-20,120},//0
                    {-20,-40, -5, -5, -5, -5,-40,-20},//6
                    {120,-20, 20,  5,  5, 20,-20,120}};//7
 
-int play(int player, int board[8][8], int *p_row, int *p_col) {
-
-  int opp = opponent(player);
+// Greedy fallback: the legal square with the highest weight, ties going
+// to the move check_sum_probs rates higher.
+static int play_greedy(int player, int board[8][8], bitboard own, bitboard opp, int *p_row, int *p_col) {
+  bitboard moves = bitboard_moves(own, opp);
   int prob = INT_MIN;
   int num = INT_MIN;
   int found = 0;
-  for (int i = 0; i < 8; i++) {
-    for (int j = 0; j < 8; j++) {
-      if (board[i][j] == player) {
-        int x = i;
-        int y = j;
-        for (int k = -1; k <= 1; k++) {
-          for (int l = -1; l <= 1; l++) {
-            int new_x = x+l;
-            int new_y = y+k;
-            int val_dir = 0;
-            while(new_x >= 0 && new_x < 8 && new_y >= 0 && new_y < 8){
-              int pos = board[new_x][new_y];
-              if(pos == player || (val_dir == 0 && pos == -1)){
-                val_dir = 0;
-                break;
-              }
-              else if(pos == opp){
-                new_x += l;
-                new_y += k;
-                val_dir = 1;
-              }
-              else if(val_dir == 1 && pos == -1){
-                int new_prob = weights[new_x][new_y];
-                if(new_prob > prob){
-                  prob = new_prob;
-                  *p_row = new_x;
-                  *p_col = new_y;
-                  found = 1;
-                }
-                if(new_prob == prob){
-                  int new_num = check_sum_probs(player, board, new_x, new_y);
-                  if(new_num > num){
-                    prob = new_prob;
-                    *p_row = new_x;
-                    *p_col = new_y;
-                    found = 1;
-                  }
-                }
-                break;
-              }
-            }
-          }
-        }
-      }
+  while(moves){
+    int square = bitboard_first(moves);
+    moves &= moves - 1;
+    int new_x = SQUARE_ROW(square);
+    int new_y = SQUARE_COL(square);
+    int new_prob = weights[new_x][new_y];
+    int new_num = new_prob >= prob ? check_sum_probs(player, board, new_x, new_y) : 0;
+    if(new_prob > prob || (new_prob == prob && new_num > num)){
+      prob = new_prob;
+      num = new_num;
+      *p_row = new_x;
+      *p_col = new_y;
+      found = 1;
     }
   }
   return found;
 }
 
+int play(int player, int board[8][8], int *p_row, int *p_col) {
+
+  bitboard own, opp;
+  bitboard_from_board(player, board, &own, &opp);
+  search_engine engine;
+  if(!search_engine_init(&engine, PLAY_TABLE_BYTES, weights)){
+    return play_greedy(player, board, own, opp, p_row, p_col);
+  }
+  long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+  engine.threads = cpus < 1 ? 1 : cpus > PLAY_MAX_THREADS ? PLAY_MAX_THREADS : cpus;
+  search_result result;
+  int square = search_move(&engine, player, own, opp, PLAY_MAX_DEPTH, PLAY_SECONDS, &result);
+  search_engine_free(&engine);
+  if(square == -1){
+    return 0;
+  }
+  *p_row = SQUARE_ROW(square);
+  *p_col = SQUARE_COL(square);
+  return 1;
+}
+
 int check_sum_probs(int player,int board[8][8], int x, int y){
   int opp = opponent(player);
   int num = 0;
@@ -0,0 +1,313 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#include "bitboard.h"
+#include "search.h"
+
+#define MAX_THREADS 256
+#define TABLE_BYTES (1 << 20)
+
+static const int default_weights[8][8]={{120,-20, 20,  5,  5, 20,-20,120},
+                                        {-20,-40, -5, -5, -5, -5,-40,-20},
+                                        { 20, -5, 15,  3,  3, 15, -5, 20},
+                                        {  5, -5,  3,  3,  3,  3, -5,  5},
+                                        {  5, -5,  3,  3,  3,  3, -5,  5},
+                                        { 20, -5, 15,  3,  3, 15, -5, 20},
+                                        {-20,-40, -5, -5, -5, -5,-40,-20},
+                                        {120,-20, 20,  5,  5, 20,-20,120}};
+
+// Everything the games read is set up before the threads start and is
+// not written again; only the tally further down is shared, under lock.
+typedef struct tournament {
+  int weights[2][8][8]; // engine A, engine B
+  int depth;
+  double seconds;
+  int endgame;
+  int random_plies;
+  int pairs;
+  uint64_t seed;
+  int sprt;
+  double elo0, elo1, alpha, beta;
+
+  pthread_mutex_t lock;
+  int next_pair;
+  int finished_pairs;
+  int wins, losses, draws; // engine A's
+  int stop;
+} tournament;
+
+static uint64_t next_random(uint64_t *state) {
+  uint64_t z = (*state += 0x9e3779b97f4a7c15ULL);
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+  return z ^ (z >> 31);
+}
+
+// Plays the random opening of a pair; both games of the pair start from
+// it. Returns 0 if the game ended during the opening.
+static int random_opening(const tournament *t, uint64_t seed, int *player, bitboard *own, bitboard *opp) {
+  bitboard_parse(BITBOARD_START, player, own, opp);
+  for (int ply = 0; ply < t->random_plies; ply++) {
+    bitboard moves = bitboard_moves(*own, *opp);
+    if(!moves){
+      if(!bitboard_moves(*opp, *own)){
+        return 0;
+      }
+      bitboard swap = *own;
+      *own = *opp;
+      *opp = swap;
+      *player = 1 - *player;
+      continue;
+    }
+    for (int skip = next_random(&seed) % bitboard_count(moves); skip > 0; skip--) {
+      moves &= moves - 1;
+    }
+    int square = bitboard_first(moves);
+    bitboard flips = bitboard_flips(*own, *opp, square);
+    bitboard mover = *own | flips | SQUARE_BIT(square);
+    *own = *opp ^ flips;
+    *opp = mover;
+    *player = 1 - *player;
+  }
+  return 1;
+}
+
+// One game with fresh engines and a board of its own. Returns engine
+// A's disc difference.
+static int play_game(const tournament *t, int player, bitboard own, bitboard opp, int a_color) {
+  search_engine engines[2];
+  for (int i = 0; i < 2; i++) {
+    if(!search_engine_init(&engines[i], TABLE_BYTES, t->weights[i])){
+      fprintf(stderr, "out of memory\n");
+      exit(1);
+    }
+    engines[i].endgame_empties = t->endgame;
+  }
+  int passes = 0;
+  while (passes < 2) {
+    bitboard moves = bitboard_moves(own, opp);
+    if(moves){
+      search_result result;
+      search_engine *engine = &engines[player == a_color ? 0 : 1];
+      int square = search_move(engine, player, own, opp, t->depth, t->seconds, &result);
+      bitboard flips = bitboard_flips(own, opp, square);
+      bitboard mover = own | flips | SQUARE_BIT(square);
+      own = opp ^ flips;
+      opp = mover;
+      passes = 0;
+    }else{
+      bitboard swap = own;
+      own = opp;
+      opp = swap;
+      passes++;
+    }
+    player = 1 - player;
+  }
+  search_engine_free(&engines[0]);
+  search_engine_free(&engines[1]);
+  int diff = bitboard_count(own) - bitboard_count(opp);
+  return player == a_color ? diff : -diff;
+}
+
+// Log-likelihood ratio of elo1 against elo0 given the results so far,
+// from the normal approximation to the per-game score. Half a win and
+// half a loss are added to the counts so that a one-sided run (all wins,
+// say) still has a variance and can reach a bound.
+static double sprt_llr(int wins, int losses, int draws, double elo0, double elo1) {
+  if(wins + losses + draws == 0){
+    return 0;
+  }
+  double w = wins + 0.5;
+  double l = losses + 0.5;
+  double n = w + l + draws;
+  double score = (w + 0.5 * draws) / n;
+  double variance = (w * (1 - score) * (1 - score) + draws * (0.5 - score) * (0.5 - score)
+                     + l * score * score) / n;
+  double s0 = 1 / (1 + pow(10, -elo0 / 400));
+  double s1 = 1 / (1 + pow(10, -elo1 / 400));
+  return n * (s1 - s0) * (2 * score - s0 - s1) / (2 * variance);
+}
+
+static double elo_from_score(double score) {
+  if(score == 0.5){
+    return 0;
+  }else if(score <= 0){
+    return -INFINITY;
+  }else if(score >= 1){
+    return INFINITY;
+  }
+  return -400 * log10(1 / score - 1);
+}
+
+static void *worker_thread(void *arg) {
+  tournament *t = arg;
+  for (;;) {
+    pthread_mutex_lock(&t->lock);
+    int pair = t->stop || t->next_pair >= t->pairs ? -1 : t->next_pair++;
+    pthread_mutex_unlock(&t->lock);
+    if(pair == -1){
+      return NULL;
+    }
+
+    int start_player;
+    bitboard start_own, start_opp;
+    uint64_t seed = t->seed + pair;
+    int tries = 0;
+    while (!random_opening(t, next_random(&seed), &start_player, &start_own, &start_opp) && ++tries < 100) {
+    }
+    int outcome[2];
+    for (int a_color = 0; a_color < 2; a_color++) {
+      outcome[a_color] = play_game(t, start_player, start_own, start_opp, a_color);
+    }
+
+    pthread_mutex_lock(&t->lock);
+    for (int i = 0; i < 2; i++) {
+      if(outcome[i] > 0){
+        t->wins++;
+      }else if(outcome[i] < 0){
+        t->losses++;
+      }else{
+        t->draws++;
+      }
+    }
+    t->finished_pairs++;
+    if(t->sprt){
+      double llr = sprt_llr(t->wins, t->losses, t->draws, t->elo0, t->elo1);
+      if(llr <= log(t->beta / (1 - t->alpha)) || llr >= log((1 - t->beta) / t->alpha)){
+        t->stop = 1;
+      }
+    }
+    pthread_mutex_unlock(&t->lock);
+  }
+}
+
+// Reads 64 integers, row by row. Anything before a '{' is skipped, so
+// a C initializer such as txt.txt loads as it is.
+static int read_weights(const char *path, int weights[8][8]) {
+  FILE *file = fopen(path, "r");
+  if(file == NULL){
+    return 0;
+  }
+  char text[4096];
+  size_t length = fread(text, 1, sizeof(text) - 1, file);
+  fclose(file);
+  text[length] = '\0';
+  char *p = strchr(text, '{');
+  p = p == NULL ? text : p + 1;
+  for (int square = 0; square < 64; square++) {
+    while (*p != '\0' && *p != '-' && (*p < '0' || *p > '9')) {
+      p++;
+    }
+    char *end;
+    long value = strtol(p, &end, 10);
+    if(end == p){
+      return 0;
+    }
+    weights[SQUARE_ROW(square)][SQUARE_COL(square)] = value;
+    p = end;
+  }
+  return 1;
+}
+
+static void usage(const char *program) {
+  fprintf(stderr, "usage: %s [--games N] [--threads N] [--depth N | --time SECONDS] [--endgame EMPTIES]"
+                  " [--random-plies N] [--seed N] [--weights-a FILE] [--weights-b FILE]"
+                  " [--sprt ELO0 ELO1]\n", program);
+}
+
+// Plays engine A against engine B, two games per random opening with
+// colors swapped, on every core, and reports A's result as Elo. --depth
+// and --time limit the midgame search only: both engines play perfectly
+// from --endgame empty squares on (12 by default, 0 never).
+int main(int argc, char const *argv[]) {
+  static tournament t;
+  memcpy(t.weights[0], default_weights, sizeof(default_weights));
+  memcpy(t.weights[1], default_weights, sizeof(default_weights));
+  t.depth = 4;
+  t.seconds = 1000;
+  t.endgame = 12;
+  t.random_plies = 8;
+  t.seed = 1;
+  t.alpha = 0.05;
+  t.beta = 0.05;
+  int games = 1000;
+  int threads = sysconf(_SC_NPROCESSORS_ONLN);
+  for (int i = 1; i < argc; i++) {
+    if(strcmp(argv[i], "--games") == 0 && i + 1 < argc){
+      games = atoi(argv[++i]);
+    }else if(strcmp(argv[i], "--threads") == 0 && i + 1 < argc){
+      threads = atoi(argv[++i]);
+    }else if(strcmp(argv[i], "--depth") == 0 && i + 1 < argc){
+      t.depth = atoi(argv[++i]);
+    }else if(strcmp(argv[i], "--time") == 0 && i + 1 < argc){
+      t.seconds = atof(argv[++i]);
+      t.depth = 60;
+    }else if(strcmp(argv[i], "--endgame") == 0 && i + 1 < argc){
+      t.endgame = atoi(argv[++i]);
+    }else if(strcmp(argv[i], "--random-plies") == 0 && i + 1 < argc){
+      t.random_plies = atoi(argv[++i]);
+    }else if(strcmp(argv[i], "--seed") == 0 && i + 1 < argc){
+      t.seed = strtoull(argv[++i], NULL, 10);
+    }else if(strcmp(argv[i], "--weights-a") == 0 && i + 1 < argc){
+      if(!read_weights(argv[++i], t.weights[0])){
+        fprintf(stderr, "cannot read 64 weights from %s\n", argv[i]);
+        return 1;
+      }
+    }else if(strcmp(argv[i], "--weights-b") == 0 && i + 1 < argc){
+      if(!read_weights(argv[++i], t.weights[1])){
+        fprintf(stderr, "cannot read 64 weights from %s\n", argv[i]);
+        return 1;
+      }
+    }else if(strcmp(argv[i], "--sprt") == 0 && i + 2 < argc){
+      t.sprt = 1;
+      t.elo0 = atof(argv[++i]);
+      t.elo1 = atof(argv[++i]);
+    }else{
+      usage(argv[0]);
+      return 1;
+    }
+  }
+  if(threads < 1){
+    threads = 1;
+  }else if(threads > MAX_THREADS){
+    threads = MAX_THREADS;
+  }
+  t.pairs = (games + 1) / 2;
+  pthread_mutex_init(&t.lock, NULL);
+
+  pthread_t workers[MAX_THREADS];
+  int started = 0;
+  while (started < threads && pthread_create(&workers[started], NULL, worker_thread, &t) == 0) {
+    started++;
+  }
+  if(started == 0){
+    worker_thread(&t);
+  }
+  for (int i = 0; i < started; i++) {
+    pthread_join(workers[i], NULL);
+  }
+  pthread_mutex_destroy(&t.lock);
+
+  int n = t.wins + t.losses + t.draws;
+  double score = n ? (t.wins + 0.5 * t.draws) / n : 0.5;
+  double variance = n ? (t.wins * (1 - score) * (1 - score) + t.draws * (0.5 - score) * (0.5 - score)
+                         + t.losses * score * score) / n : 0;
+  double margin = 1.96 * sqrt(variance / (n ? n : 1));
+  printf("%d games: A %d wins, %d losses, %d draws (%.1f%%)\n", n, t.wins, t.losses, t.draws, 100 * score);
+  printf("elo %.1f [%.1f, %.1f] at 95%%\n", elo_from_score(score),
+         elo_from_score(score - margin), elo_from_score(score + margin));
+  if(t.sprt){
+    double llr = sprt_llr(t.wins, t.losses, t.draws, t.elo0, t.elo1);
+    double lower = log(t.beta / (1 - t.alpha));
+    double upper = log((1 - t.beta) / t.alpha);
+    const char *verdict = llr >= upper ? "H1 accepted" : llr <= lower ? "H0 accepted" : "inconclusive";
+    printf("sprt elo0 %.1f elo1 %.1f: llr %.2f [%.2f, %.2f], %s\n", t.elo0, t.elo1, llr, lower, upper, verdict);
+  }
+  return 0;
+}
@@ -0,0 +1,445 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+
+#include "search.h"
+
+#define BOUND_EXACT 0
+#define BOUND_LOWER 1
+#define BOUND_UPPER 2
+
+#define NO_MOVE 0xff
+#define MOBILITY_WEIGHT 8
+// Nodes between two looks at the clock.
+#define CLOCK_INTERVAL 4095
+// Share of the table budget given to the endgame solver's table.
+#define ENDGAME_TABLE_SHARE 4
+// Depth of the quick search that provides a move in case the endgame
+// solver runs out of time.
+#define ENDGAME_FALLBACK_DEPTH 6
+
+// One searching thread. Only the table is shared between workers; the
+// history each one builds up also makes their move orders drift apart,
+// which is what keeps lazy SMP helpers from duplicating each other.
+typedef struct search_worker {
+  search_engine *engine;
+  int id;
+  int player;
+  bitboard own;
+  bitboard opp;
+  uint64_t key;
+  int max_depth;
+  double start;
+  int history[64];
+  eval_state patterns;
+  long long nodes;
+  int move;
+  int score;
+  int depth;
+} search_worker;
+
+static double now(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static uint64_t splitmix64(uint64_t *state) {
+  uint64_t z = (*state += 0x9e3779b97f4a7c15ULL);
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+  return z ^ (z >> 31);
+}
+
+// Largest power of two entries of entry_size fitting in bytes, at least 1.
+static size_t table_entries(size_t bytes, size_t entry_size) {
+  size_t entries = 1;
+  while (entries * 2 * entry_size <= bytes) {
+    entries *= 2;
+  }
+  return entries;
+}
+
+int search_engine_init(search_engine *engine, size_t table_bytes, const int weights[8][8]) {
+  size_t entries = table_entries(table_bytes, sizeof(tt_entry));
+  size_t endgame_entries = table_entries(table_bytes / ENDGAME_TABLE_SHARE, sizeof(endgame_entry));
+  if(!eval_init(&engine->eval, weights)){
+    return 0;
+  }
+  engine->table = calloc(entries, sizeof(tt_entry));
+  engine->endgame_table = calloc(endgame_entries, sizeof(endgame_entry));
+  if(engine->table == NULL || engine->endgame_table == NULL){
+    search_engine_free(engine);
+    return 0;
+  }
+  engine->table_mask = entries - 1;
+  engine->endgame_mask = endgame_entries - 1;
+  engine->age = 0;
+  // Fixed seed: every engine hashes a position the same way.
+  uint64_t seed = 0;
+  for (int color = 0; color < 2; color++) {
+    for (int square = 0; square < 64; square++) {
+      engine->zobrist[color][square] = splitmix64(&seed);
+    }
+  }
+  engine->zobrist_side = splitmix64(&seed);
+  engine->weights = weights;
+  engine->threads = 1;
+  engine->endgame_empties = ENDGAME_EMPTIES;
+  return 1;
+}
+
+void search_engine_free(search_engine *engine) {
+  free(engine->table);
+  free(engine->endgame_table);
+  engine->table = NULL;
+  engine->endgame_table = NULL;
+  eval_free(&engine->eval);
+}
+
+static uint64_t hash_position(const search_engine *engine, int player, bitboard own, bitboard opp) {
+  uint64_t key = player ? engine->zobrist_side : 0;
+  for (bitboard b = own; b; b &= b - 1) {
+    key ^= engine->zobrist[player][bitboard_first(b)];
+  }
+  for (bitboard b = opp; b; b &= b - 1) {
+    key ^= engine->zobrist[1 - player][bitboard_first(b)];
+  }
+  return key;
+}
+
+// Key after the player of color plays square, turning over flips.
+static uint64_t hash_move(const search_engine *engine, uint64_t key, int color, int square, bitboard flips) {
+  key ^= engine->zobrist_side ^ engine->zobrist[color][square];
+  for (; flips; flips &= flips - 1) {
+    int flipped = bitboard_first(flips);
+    key ^= engine->zobrist[0][flipped] ^ engine->zobrist[1][flipped];
+  }
+  return key;
+}
+
+static int square_weight(const search_engine *engine, int square) {
+  return engine->weights[SQUARE_ROW(square)][SQUARE_COL(square)];
+}
+
+// Score of a game that ends diff discs up.
+static int exact_score(int diff) {
+  if(diff > 0){
+    return SCORE_WIN + diff;
+  }else if(diff < 0){
+    return -SCORE_WIN + diff;
+  }
+  return 0;
+}
+
+static int final_score(bitboard own, bitboard opp) {
+  return exact_score(bitboard_count(own) - bitboard_count(opp));
+}
+
+// Pattern tables plus mobility, from the point of view of color, whose
+// stones are own.
+static int evaluate(const search_worker *worker, int color, bitboard own, bitboard opp, bitboard moves) {
+  int score = eval_score(&worker->engine->eval, &worker->patterns);
+  if(color == 1){
+    score = -score;
+  }
+  int mobility = bitboard_count(moves) - bitboard_count(bitboard_moves(opp, own));
+  return score + MOBILITY_WEIGHT * mobility;
+}
+
+static uint64_t tt_pack(int score, int depth, int bound, int move, unsigned age) {
+  return (uint64_t)(uint16_t)score
+       | (uint64_t)depth << 16
+       | (uint64_t)bound << 24
+       | (uint64_t)move << 32
+       | (uint64_t)(age & 0xff) << 40;
+}
+
+static int tt_score(uint64_t data) {
+  return (int16_t)(data & 0xffff);
+}
+
+static int tt_depth(uint64_t data) {
+  return (data >> 16) & 0xff;
+}
+
+static int tt_bound(uint64_t data) {
+  return (data >> 24) & 0xff;
+}
+
+static int tt_move(uint64_t data) {
+  return (data >> 32) & 0xff;
+}
+
+static unsigned tt_age(uint64_t data) {
+  return (data >> 40) & 0xff;
+}
+
+static int tt_probe(const search_engine *engine, uint64_t key, uint64_t *data) {
+  const tt_entry *entry = &engine->table[key & engine->table_mask];
+  uint64_t stored = __atomic_load_n(&entry->key, __ATOMIC_RELAXED);
+  uint64_t stored_data = __atomic_load_n(&entry->data, __ATOMIC_RELAXED);
+  if(stored_data == 0 || (stored ^ stored_data) != key){
+    return 0;
+  }
+  *data = stored_data;
+  return 1;
+}
+
+// Keeps the deeper result unless the slot is left over from an earlier move.
+static void tt_store(search_engine *engine, uint64_t key, int score, int depth, int bound, int move) {
+  tt_entry *entry = &engine->table[key & engine->table_mask];
+  uint64_t stored = __atomic_load_n(&entry->key, __ATOMIC_RELAXED);
+  uint64_t stored_data = __atomic_load_n(&entry->data, __ATOMIC_RELAXED);
+  if(stored_data != 0 && tt_age(stored_data) == (engine->age & 0xff)
+     && (stored ^ stored_data) != key && tt_depth(stored_data) > depth){
+    return;
+  }
+  uint64_t data = tt_pack(score, depth, bound, move, engine->age);
+  __atomic_store_n(&entry->key, key ^ data, __ATOMIC_RELAXED);
+  __atomic_store_n(&entry->data, data, __ATOMIC_RELAXED);
+}
+
+// Fills list with the moves in search order: the table move, then by
+// cutoff history and square weight. Returns how many there are.
+static int order_moves(const search_worker *worker, bitboard moves, int first, int list[64]) {
+  int keys[64];
+  int count = 0;
+  for (; moves; moves &= moves - 1) {
+    int square = bitboard_first(moves);
+    int key = square == first ? INT32_MAX : worker->history[square] + square_weight(worker->engine, square);
+    int i = count++;
+    while (i > 0 && keys[i - 1] < key) {
+      keys[i] = keys[i - 1];
+      list[i] = list[i - 1];
+      i--;
+    }
+    keys[i] = key;
+    list[i] = square;
+  }
+  return count;
+}
+
+static int stopped(const search_engine *engine) {
+  return __atomic_load_n(&engine->stop, __ATOMIC_RELAXED);
+}
+
+static int negamax(search_worker *worker, int color, bitboard own, bitboard opp, uint64_t key,
+                   int depth, int alpha, int beta, int passed, int *best_move) {
+  search_engine *engine = worker->engine;
+  worker->nodes++;
+  if((worker->nodes & CLOCK_INTERVAL) == 0 && now() > engine->deadline){
+    __atomic_store_n(&engine->stop, 1, __ATOMIC_RELAXED);
+  }
+  if(stopped(engine)){
+    return 0;
+  }
+  bitboard moves = bitboard_moves(own, opp);
+  if(!moves){
+    if(passed){
+      return final_score(own, opp);
+    }
+    return -negamax(worker, 1 - color, opp, own, key ^ engine->zobrist_side,
+                    depth, -beta, -alpha, 1, NULL);
+  }
+  if(depth == 0){
+    return evaluate(worker, color, own, opp, moves);
+  }
+
+  int first = NO_MOVE;
+  uint64_t data;
+  if(tt_probe(engine, key, &data)){
+    first = tt_move(data);
+    if(best_move == NULL && tt_depth(data) >= depth){
+      int score = tt_score(data);
+      int bound = tt_bound(data);
+      if(bound == BOUND_EXACT
+         || (bound == BOUND_LOWER && score >= beta)
+         || (bound == BOUND_UPPER && score <= alpha)){
+        return score;
+      }
+    }
+  }
+
+  int list[64];
+  int count = order_moves(worker, moves, first, list);
+  int original_alpha = alpha;
+  int best = -SCORE_INFINITY;
+  int best_square = list[0];
+  for (int i = 0; i < count; i++) {
+    int square = list[i];
+    bitboard flips = bitboard_flips(own, opp, square);
+    bitboard child_own = opp ^ flips;
+    bitboard child_opp = own | flips | SQUARE_BIT(square);
+    uint64_t child_key = hash_move(engine, key, color, square, flips);
+    eval_play(&engine->eval, &worker->patterns, color, square, flips);
+    int score;
+    if(i == 0){
+      score = -negamax(worker, 1 - color, child_own, child_opp, child_key,
+                       depth - 1, -beta, -alpha, 0, NULL);
+    }else{
+      // Later moves only have to prove they are no better than the best.
+      score = -negamax(worker, 1 - color, child_own, child_opp, child_key,
+                       depth - 1, -alpha - 1, -alpha, 0, NULL);
+      if(score > alpha && score < beta){
+        score = -negamax(worker, 1 - color, child_own, child_opp, child_key,
+                         depth - 1, -beta, -alpha, 0, NULL);
+      }
+    }
+    eval_undo(&engine->eval, &worker->patterns, color, square, flips);
+    if(stopped(engine)){
+      return 0;
+    }
+    if(score > best){
+      best = score;
+      best_square = square;
+    }
+    if(score > alpha){
+      alpha = score;
+    }
+    if(alpha >= beta){
+      worker->history[square] += depth * depth;
+      break;
+    }
+  }
+
+  int bound = BOUND_EXACT;
+  if(best <= original_alpha){
+    bound = BOUND_UPPER;
+  }else if(best >= beta){
+    bound = BOUND_LOWER;
+  }
+  tt_store(engine, key, best, depth, bound, best_square);
+  if(best_move != NULL){
+    *best_move = best_square;
+  }
+  return best;
+}
+
+// Iterative deepening for one worker. Helpers with an odd id start one
+// ply deeper, so the threads spread over two depths at a time.
+static void deepen(search_worker *worker) {
+  search_engine *engine = worker->engine;
+  int empties = 64 - bitboard_count(worker->own | worker->opp);
+  for (int depth = 1 + (worker->id & 1); depth <= worker->max_depth; depth++) {
+    int move;
+    int score = negamax(worker, worker->player, worker->own, worker->opp, worker->key,
+                        depth, -SCORE_INFINITY, SCORE_INFINITY, 0, &move);
+    if(stopped(engine)){
+      break;
+    }
+    worker->move = move;
+    worker->score = score;
+    worker->depth = depth;
+    // Past the last empty square the score is exact.
+    if(depth >= empties){
+      break;
+    }
+    // An iteration costs several times the previous one, so half the
+    // budget is the last point where starting another can pay off.
+    if(worker->id == 0 && now() - worker->start > (engine->deadline - worker->start) / 2){
+      break;
+    }
+  }
+}
+
+static void *helper_thread(void *arg) {
+  deepen(arg);
+  return NULL;
+}
+
+int search_move(search_engine *engine, int player, bitboard own, bitboard opp,
+                int max_depth, double seconds, search_result *result) {
+  double start = now();
+  bitboard moves = bitboard_moves(own, opp);
+  result->move = -1;
+  result->score = 0;
+  result->depth = 0;
+  result->nodes = 0;
+  result->seconds = 0;
+  result->nodes_per_second = 0;
+  if(!moves){
+    return -1;
+  }
+
+  engine->age++;
+  engine->stop = 0;
+  engine->deadline = start + seconds;
+  int threads = engine->threads;
+  if(threads < 1){
+    threads = 1;
+  }else if(threads > SEARCH_MAX_THREADS){
+    threads = SEARCH_MAX_THREADS;
+  }
+  search_worker workers[SEARCH_MAX_THREADS];
+  pthread_t helpers[SEARCH_MAX_THREADS];
+  int empties = 64 - bitboard_count(own | opp);
+  int solving = empties <= engine->endgame_empties;
+  if(solving && max_depth > ENDGAME_FALLBACK_DEPTH){
+    max_depth = ENDGAME_FALLBACK_DEPTH;
+  }
+  int list[64];
+  for (int i = 0; i < threads; i++) {
+    search_worker *worker = &workers[i];
+    memset(worker, 0, sizeof(*worker));
+    worker->engine = engine;
+    worker->id = i;
+    worker->player = player;
+    worker->own = own;
+    worker->opp = opp;
+    worker->key = hash_position(engine, player, own, opp);
+    worker->max_depth = max_depth;
+    worker->start = start;
+    eval_set(&engine->eval, &worker->patterns, player == 0 ? own : opp, player == 0 ? opp : own);
+    order_moves(worker, moves, NO_MOVE, list);
+    worker->move = list[0];
+  }
+
+  // Helpers that fail to start only cost parallelism.
+  int started = 1;
+  while (started < threads && pthread_create(&helpers[started], NULL, helper_thread, &workers[started]) == 0) {
+    started++;
+  }
+  deepen(&workers[0]);
+  __atomic_store_n(&engine->stop, 1, __ATOMIC_RELAXED);
+  for (int i = 1; i < started; i++) {
+    pthread_join(helpers[i], NULL);
+  }
+
+  // The deepest finished iteration wins; the main thread on ties.
+  search_worker *best = &workers[0];
+  for (int i = 0; i < started; i++) {
+    if(workers[i].depth > best->depth){
+      best = &workers[i];
+    }
+    result->nodes += workers[i].nodes;
+  }
+  result->move = best->move;
+  result->score = best->score;
+  result->depth = best->depth;
+
+  if(solving){
+    endgame_solver solver;
+    solver.table = engine->endgame_table;
+    solver.table_mask = engine->endgame_mask;
+    solver.nodes = 0;
+    solver.deadline = engine->deadline;
+    solver.stop = 0;
+    int diff;
+    int square = endgame_best_move(&solver, own, opp, &diff);
+    if(square != -1){
+      result->move = square;
+      result->score = exact_score(diff);
+      result->depth = empties;
+    }
+    result->nodes += solver.nodes;
+  }
+  result->seconds = now() - start;
+  if(result->seconds > 0){
+    result->nodes_per_second = result->nodes / result->seconds;
+  }
+  return result->move;
+}
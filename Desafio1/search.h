@@ -0,0 +1,68 @@
+#ifndef SEARCH_H
+#define SEARCH_H
+
+#include <stddef.h>
+
+#include "bitboard.h"
+#include "endgame.h"
+#include "eval.h"
+
+#define SCORE_INFINITY 32000
+// Finished games score SCORE_WIN plus the disc difference, so any win
+// beats any heuristic evaluation.
+#define SCORE_WIN 30000
+
+// One transposition table slot; data packs score, depth, bound, best
+// move and the search it was written by. Threads read and write slots
+// without locks, so key holds the hash XOR data: a slot torn by two
+// writers fails the key check instead of returning a mixed entry.
+typedef struct tt_entry {
+  uint64_t key;
+  uint64_t data;
+} tt_entry;
+
+#define SEARCH_MAX_THREADS 64
+
+// Everything one search needs. Engines share nothing, so any number of
+// them can play at once; within an engine, threads searchers share the
+// transposition table (lazy SMP) and keep everything else to themselves.
+typedef struct search_engine {
+  tt_entry *table;
+  size_t table_mask;
+  unsigned age;
+  uint64_t zobrist[2][64];
+  uint64_t zobrist_side;
+  const int (*weights)[8];
+  eval_tables eval;
+  int threads;
+  int endgame_empties;
+  endgame_entry *endgame_table;
+  size_t endgame_mask;
+  double deadline;
+  int stop;
+} search_engine;
+
+typedef struct search_result {
+  int move;
+  int score;
+  int depth;
+  long long nodes;
+  double seconds;
+  double nodes_per_second;
+} search_result;
+
+// table_bytes caps the transposition table; weights is the square table
+// the evaluation tables are built from and move ordering uses. The
+// engine searches with one thread until engine->threads is raised, and
+// solves exactly from engine->endgame_empties empty squares on
+// (ENDGAME_EMPTIES; 0 never). Returns 0 if out of memory.
+int search_engine_init(search_engine *engine, size_t table_bytes, const int weights[8][8]);
+void search_engine_free(search_engine *engine);
+
+// Iterative deepening from player's point of view (own are player's
+// stones) until max_depth or seconds run out. Returns the chosen
+// square, or -1 when player has to pass.
+int search_move(search_engine *engine, int player, bitboard own, bitboard opp,
+                int max_depth, double seconds, search_result *result);
+
+#endif
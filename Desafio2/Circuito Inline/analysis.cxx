@@ -0,0 +1,41 @@
+#include "analysis.hxx"
+
+static bdd_manager::operation bdd_op(opcode op) {
+  return op == OP_AND ? bdd_manager::AND : op == OP_OR ? bdd_manager::OR : bdd_manager::XOR;
+}
+
+int build_bdd(bdd_manager &m, const circuit &c) {
+  const std::vector<instruction> &code = c.get_code();
+  std::vector<int> stack;
+  for(std::vector<instruction>::size_type i = 0; i != code.size(); i++) {
+    if(code[i].op == OP_LOAD){
+      stack.push_back(m.variable(code[i].slot));
+    }else{
+      int b = stack.back();
+      stack.pop_back();
+      stack.back() = m.apply(bdd_op(code[i].op), stack.back(), b);
+    }
+  }
+  return stack[0];
+}
+
+std::vector<int> build_bdds(bdd_manager &m, const netlist &net) {
+  const std::vector<gate> &gates = net.get_gates();
+  const std::vector<int> &schedule = net.get_schedule();
+  std::vector<int> value(gates.size(), 0);
+  for(std::vector<int>::size_type i = 0; i != schedule.size(); i++) {
+    const gate &g = gates[schedule[i]];
+    if(g.op == GATE_INPUT){
+      value[schedule[i]] = m.variable(g.a);
+    }else{
+      bdd_manager::operation op = g.op == GATE_AND ? bdd_manager::AND :
+                                  g.op == GATE_OR ? bdd_manager::OR : bdd_manager::XOR;
+      value[schedule[i]] = m.apply(op, value[g.a], value[g.b]);
+    }
+  }
+  std::vector<int> outputs(net.num_outputs());
+  for (int k = 0; k < net.num_outputs(); k++) {
+    outputs[k] = value[net.output(k)];
+  }
+  return outputs;
+}
@@ -0,0 +1,18 @@
+#ifndef ANALYSIS_HXX
+#define ANALYSIS_HXX
+
+#include "bdd.hxx"
+#include "circuit.hxx"
+#include "netlist.hxx"
+#include <vector>
+
+// Symbolic versions of the parsed circuits, so questions such as "which
+// input makes the output 1?" or "are these equal?" are answered without
+// enumerating 2^n rows. Variable i of the manager is input slot i.
+
+// The BDD of the expression.
+int build_bdd(bdd_manager &m, const circuit &c);
+// One BDD per output, in output order; shared gates are built once.
+std::vector<int> build_bdds(bdd_manager &m, const netlist &net);
+
+#endif
@@ -0,0 +1,125 @@
+#include "bdd.hxx"
+
+#include <stdexcept>
+#include <cmath>
+
+static const int CACHE_SIZE = 1 << 20;
+
+//Constructor/Destructor
+bdd_manager::bdd_manager(int num_vars, size_t max_nodes) {
+  this->num_vars = num_vars;
+  this->max_nodes = max_nodes;
+  // The terminals sit below every variable.
+  bdd_node terminal = {num_vars, 0, 0};
+  nodes.push_back(terminal);
+  terminal.low = terminal.high = 1;
+  nodes.push_back(terminal);
+  cache_entry empty = {-1, 0, 0, 0};
+  cache.assign(CACHE_SIZE, empty);
+}
+
+bdd_manager::~bdd_manager() {
+}
+
+//Nodes
+int bdd_manager::make(int var, int low, int high) {
+  if(low == high){
+    return low;
+  }
+  bdd_node n = {var, low, high};
+  std::unordered_map<bdd_node, int, node_hash, node_equal>::const_iterator it = unique.find(n);
+  if(it != unique.end()){
+    return it->second;
+  }
+  if(nodes.size() >= max_nodes){
+    throw std::runtime_error("BDD grew past its node limit");
+  }
+  int id = nodes.size();
+  nodes.push_back(n);
+  unique[n] = id;
+  return id;
+}
+
+int bdd_manager::variable(int i) {
+  return make(i, 0, 1);
+}
+
+int bdd_manager::size() const {
+  return nodes.size();
+}
+
+//Apply
+int bdd_manager::apply(operation op, int f, int g) {
+  switch (op) {
+    case AND:
+      if(f == 0 || g == 0) return 0;
+      if(f == 1 || f == g) return g;
+      if(g == 1) return f;
+      break;
+    case OR:
+      if(f == 1 || g == 1) return 1;
+      if(f == 0 || f == g) return g;
+      if(g == 0) return f;
+      break;
+    case XOR:
+      if(f == g) return 0;
+      if(f == 0) return g;
+      if(g == 0) return f;
+      break;
+  }
+  if(f > g){
+    int temp = f;
+    f = g;
+    g = temp;
+  }
+  size_t slot = ((size_t) f * 2654435761u ^ (size_t) g * 40503u ^ op) & (CACHE_SIZE - 1);
+  if(cache[slot].op == op && cache[slot].f == f && cache[slot].g == g){
+    return cache[slot].result;
+  }
+
+  int var = nodes[f].var < nodes[g].var ? nodes[f].var : nodes[g].var;
+  int f0 = nodes[f].var == var ? nodes[f].low : f;
+  int f1 = nodes[f].var == var ? nodes[f].high : f;
+  int g0 = nodes[g].var == var ? nodes[g].low : g;
+  int g1 = nodes[g].var == var ? nodes[g].high : g;
+  int low = apply(op, f0, g0);
+  int high = apply(op, f1, g1);
+  int result = make(var, low, high);
+
+  cache_entry entry = {op, f, g, result};
+  cache[slot] = entry;
+  return result;
+}
+
+//Queries
+bool bdd_manager::satisfy(int f, std::vector<int> &assignment) const {
+  assignment.assign(num_vars, 0);
+  if(f == 0){
+    return false;
+  }
+  // Every non-constant node of a reduced BDD reaches 1, so greedily
+  // following any non-0 branch ends at 1.
+  while (f != 1) {
+    if(nodes[f].low != 0){
+      f = nodes[f].low;
+    }else{
+      assignment[nodes[f].var] = 1;
+      f = nodes[f].high;
+    }
+  }
+  return true;
+}
+
+long double bdd_manager::count(int f) const {
+  if(f < 2){
+    return f ? std::ldexp(1.0L, num_vars) : 0;
+  }
+  // Fraction of assignments reaching 1, bottom-up over node ids (children
+  // always have smaller ids than their parents).
+  std::vector<long double> fraction(f + 1, 0);
+  fraction[1] = 1;
+  for (int id = 2; id <= f; id++) {
+    fraction[id] = (fraction[nodes[id].low] + fraction[nodes[id].high]) / 2;
+  }
+  return std::ldexp(fraction[f], num_vars);
+}
@@ -0,0 +1,63 @@
+#ifndef BDD_HXX
+#define BDD_HXX
+
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+#include <cstddef>
+
+// Reduced ordered binary decision diagrams over variables 0..n-1, in that
+// order. A function is a node id; 0 and 1 are the constant functions.
+// Equal functions always get the same id, so equivalence is ==.
+class bdd_manager {
+public:
+  enum operation { AND, OR, XOR };
+
+private:
+  struct bdd_node {
+    int var;
+    int low;  // var = 0
+    int high; // var = 1
+  };
+  struct node_hash {
+    std::size_t operator()(const bdd_node &n) const {
+      return ((std::size_t) n.var * 12582917) ^ ((std::size_t) n.low * 4256249) ^ (std::size_t) n.high * 741457;
+    }
+  };
+  struct node_equal {
+    bool operator()(const bdd_node &a, const bdd_node &b) const {
+      return a.var == b.var && a.low == b.low && a.high == b.high;
+    }
+  };
+  struct cache_entry {
+    int op;
+    int f;
+    int g;
+    int result;
+  };
+
+  int num_vars;
+  std::size_t max_nodes;
+  std::vector<bdd_node> nodes;
+  std::unordered_map<bdd_node, int, node_hash, node_equal> unique;
+  std::vector<cache_entry> cache; // direct mapped apply() results
+
+  int make(int var, int low, int high);
+
+public:
+  // Throws std::runtime_error from apply() once max_nodes is exceeded.
+  bdd_manager(int num_vars, std::size_t max_nodes);
+  ~bdd_manager();
+
+  int variable(int i);
+  int apply(operation op, int f, int g);
+
+  int size() const;
+  // Some input with f = 1 (variables off the path are 0); false when f is
+  // the constant 0.
+  bool satisfy(int f, std::vector<int> &assignment) const;
+  // Number of assignments of all num_vars variables with f = 1.
+  long double count(int f) const;
+};
+
+#endif
@@ -0,0 +1,101 @@
+#include "circuit.hxx"
+
+#include <stdexcept>
+
+//Constructor/Destructor
+circuit::circuit(const symbol_table &symbols, const std::string &opp) {
+  this->symbols = symbols;
+  num_inputs = symbols.size();
+
+  int depth = 0;
+  max_depth = 0;
+  std::string::size_type i = 0;
+  while (i < opp.size()) {
+    instruction ins;
+    ins.slot = -1;
+    std::string::size_type length = 1;
+    switch (opp[i]) {
+      case ' ':
+      case '\t':
+        i++;
+        continue;
+      case '&':
+        ins.op = OP_AND;
+        break;
+      case '|':
+        ins.op = OP_OR;
+        break;
+      case '^':
+        ins.op = OP_XOR;
+        break;
+      default:
+        ins.op = OP_LOAD;
+        ins.slot = symbols.match(opp, i, length);
+        if(ins.slot == -1){
+          throw std::runtime_error("WRONG SINTAX: unknown variable at '" + opp.substr(i) + "'");
+        }
+    }
+    if(ins.op == OP_LOAD){
+      depth++;
+      if(depth > max_depth){
+        max_depth = depth;
+      }
+    }else if(depth < 2){
+      throw std::runtime_error(std::string("WRONG SINTAX: '") + opp[i] + "' needs two arguments");
+    }else{
+      depth--;
+    }
+    code.push_back(ins);
+    i += length;
+  }
+  if(depth != 1){
+    throw std::runtime_error("WRONG SINTAX: expression must leave exactly one value");
+  }
+}
+
+circuit::~circuit() {
+}
+
+//Accessors
+int circuit::inputs() const {
+  return num_inputs;
+}
+
+int circuit::depth() const {
+  return max_depth;
+}
+
+const std::vector<instruction> &circuit::get_code() const {
+  return code;
+}
+
+const symbol_table &circuit::get_symbols() const {
+  return symbols;
+}
+
+//Evaluation
+int circuit::evaluate(const int *row, int *stack) const {
+  int top = -1;
+  const instruction *ip = code.data();
+  const instruction *end = ip + code.size();
+  for (; ip != end; ++ip) {
+    switch (ip->op) {
+      case OP_LOAD:
+        stack[++top] = row[ip->slot];
+        break;
+      case OP_AND:
+        stack[top - 1] &= stack[top];
+        top--;
+        break;
+      case OP_OR:
+        stack[top - 1] |= stack[top];
+        top--;
+        break;
+      case OP_XOR:
+        stack[top - 1] ^= stack[top];
+        top--;
+        break;
+    }
+  }
+  return stack[0];
+}
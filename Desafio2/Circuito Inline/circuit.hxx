@@ -0,0 +1,88 @@
+#ifndef CIRCUIT_HXX
+#define CIRCUIT_HXX
+
+#include <vector>
+#include <string>
+#include <cstdint>
+
+#include "symbol_table.hxx"
+
+// Bit-sliced words: lane i of every word belongs to row i, so one logic
+// operation evaluates 64, 256 or 512 rows. The wide types are GCC vector
+// extensions; they become single AVX2/AVX-512 instructions when the
+// target has them and pairs of narrower ones otherwise.
+typedef uint64_t word64;
+typedef uint64_t word256 __attribute__((vector_size(32)));
+typedef uint64_t word512 __attribute__((vector_size(64)));
+
+enum opcode {
+  OP_LOAD, // push the input in slot
+  OP_AND,  // pop two, push a & b
+  OP_OR,   // pop two, push a | b
+  OP_XOR   // pop two, push a ^ b
+};
+
+struct instruction {
+  opcode op;
+  int slot;
+};
+
+// A postfix expression compiled once into a flat instruction array whose
+// operands are already resolved to input slots (the position of the
+// parameter in the symbol table). Evaluating a row is then a tight loop
+// over an operand stack, with no parsing or lookups.
+class circuit {
+private:
+  symbol_table symbols;
+  std::vector<instruction> code;
+  int num_inputs;
+  int max_depth;
+
+public:
+  // Operands are the longest declared name at each position, so names may
+  // be several characters long; blanks may separate tokens. Throws
+  // std::runtime_error for unknown variables or unbalanced expressions.
+  circuit(const symbol_table &symbols, const std::string &opp);
+  ~circuit();
+
+  int inputs() const;
+  // Operand stack slots evaluate() needs.
+  int depth() const;
+  const std::vector<instruction> &get_code() const;
+  const symbol_table &get_symbols() const;
+
+  // row holds one value per input slot; stack must have depth() entries.
+  int evaluate(const int *row, int *stack) const;
+
+  // Same program over bit-sliced inputs: inputs[slot] packs that input for
+  // every lane. W is word64, word256 or word512; stack needs depth() words.
+  // The result is left in stack[0].
+  template <typename W>
+  const W &evaluate_sliced(const W *inputs, W *stack) const {
+    int top = -1;
+    const instruction *ip = code.data();
+    const instruction *end = ip + code.size();
+    for (; ip != end; ++ip) {
+      switch (ip->op) {
+        case OP_LOAD:
+          stack[++top] = inputs[ip->slot];
+          break;
+        case OP_AND:
+          stack[top - 1] &= stack[top];
+          top--;
+          break;
+        case OP_OR:
+          stack[top - 1] |= stack[top];
+          top--;
+          break;
+        case OP_XOR:
+          stack[top - 1] ^= stack[top];
+          top--;
+          break;
+      }
+    }
+    return stack[0];
+  }
+};
+
+#endif
@@ -1,110 +1,304 @@
 #include <iostream>
 #include <string>
-#include <sstream>
 #include <vector>
-#include <iterator>
-#include <fstream>
-#include <map>
-
-std::ifstream infile("in.txt");
-
-int main() {
-  std::string in;
-  std::vector<char> params;
-  std::vector<int> items;
-  char char_item;
-  int int_item;
-  char val;
-  int macro_val[2]  = {-1,-1};
-  int list_val[2]   = {-1,-1};
-
-  int num_of_params;
-  infile >> num_of_params;
-  //num_of_params++;
+#include <cstring>
+#include <cstdlib>
+#include <cmath>
+#include <random>
+#include <sstream>
+#include <iomanip>
+
+#include "tokenizer.hxx"
+#include "circuit.hxx"
+#include "netlist.hxx"
+#include "evaluator.hxx"
+#include "truth_table.hxx"
+#include "pipeline.hxx"
+#include "jit.hxx"
+#include "analysis.hxx"
+
+// Nodes a symbolic analysis may create before giving up.
+static const size_t BDD_NODE_LIMIT = 1 << 24;
+
+// Reads the parameter names and the postfix expression, which is the rest
+// of the header line (or the next line when that is empty).
+static circuit read_circuit(tokenizer &infile, int num_of_params) {
+  symbol_table params;
+  std::string name;
 
   for (int i = 0; i < num_of_params; i++) {
-    infile >> char_item;
-    params.push_back(char_item);
+    infile.read_word(name);
+    params.add(name);
   }
 
   std::string opp;
-  infile >> opp;
+  infile.read_line(opp);
+  if(opp.find_first_not_of(" \t") == std::string::npos){
+    infile.read_line(opp);
+  }
+  return circuit(params, opp);
+}
+
+// Splits a line on blanks.
+static std::vector<std::string> split(const std::string &line) {
+  std::vector<std::string> words;
+  std::string::size_type i = 0;
+  while (true) {
+    i = line.find_first_not_of(" \t", i);
+    if(i == std::string::npos){
+      return words;
+    }
+    std::string::size_type end = line.find_first_of(" \t", i);
+    words.push_back(line.substr(i, end == std::string::npos ? std::string::npos : end - i));
+    i = end;
+  }
+}
+
+// Netlist section, after the "netlist" keyword line:
+//   inputs A B C
+//   NAME = postfix expression      (one per gate, over earlier signals)
+//   outputs NAME NAME ...          (ends the section)
+// Blank lines and lines starting with '#' are ignored.
+static void read_netlist(tokenizer &infile, netlist &net) {
+  std::string line;
+  while (infile.read_line(line)) {
+    std::vector<std::string> words = split(line);
+    if(words.empty() || words[0][0] == '#'){
+      continue;
+    }
+    if(words[0] == "inputs"){
+      for(std::vector<std::string>::size_type i = 1; i < words.size(); i++) {
+        net.add_input(words[i]);
+      }
+    }else if(words[0] == "outputs"){
+      for(std::vector<std::string>::size_type i = 1; i < words.size(); i++) {
+        net.add_output(words[i]);
+      }
+      net.finish();
+      return;
+    }else if(words.size() >= 2 && words[1] == "="){
+      net.define(words[0], line.substr(line.find('=') + 1));
+    }else{
+      infile.fail("expected 'inputs', 'outputs' or 'NAME = expression'");
+    }
+  }
+  infile.fail("netlist has no 'outputs' line");
+}
 
-  int n;
-  infile >> n;
-  std::cout << n;
-  std::cout << std::endl;
+// Evaluates the rows listed in the input, 64 at a time: each row becomes
+// one bit of every input word. With threads > 0 parsing, evaluation and
+// output run as a pipeline instead.
+static int evaluate(tokenizer &infile, evaluator &e, int threads) {
+  int num_of_params = e.inputs();
+  int m = e.outputs();
+  long long n;
+  n = infile.read_int();
+  std::cout << n << '\n';
+  if(threads > 0){
+    evaluate_pipelined(infile, e, n, threads, std::cout);
+    return 0;
+  }
 
-  std::map<char, int> map;
+  std::vector<word64> inputs(num_of_params);
+  std::vector<word64> results(m);
+  std::string text;
   while (n > 0)
   {
-    for (int j = 0; j < num_of_params; j++) {
-      infile >> int_item;
-      map[params[j]] = int_item;
-    }
-    for(std::string::size_type i = 0; i < opp.size(); ++i) {
-      val = opp[i];
-      switch (val) {
-        case '&':
-          if(macro_val[0] == -1){
-            macro_val[0] = list_val[0] & list_val[1];
-          }else if(macro_val[1] == -1 && list_val[1] == -1){
-            macro_val[0] &= list_val[0];
-          }else if(macro_val[1] == -1 && list_val[1] != -1){
-            macro_val[1] = list_val[0] & list_val[1];
-          }else{
-            macro_val[0] &= macro_val[1];
-            macro_val[1] = -1;
-          }
-          list_val[0] = -1;
-          list_val[1] = -1;
-          break;
-        case '|':
-          if(macro_val[0] == -1){
-            macro_val[0] = list_val[0] | list_val[1];
-          }else if(macro_val[1] == -1 && list_val[1] == -1){
-            macro_val[0] |= list_val[0];
-          }else if(macro_val[1] == -1 && list_val[1] != -1){
-            macro_val[1] = list_val[0] | list_val[1];
-          }else{
-            macro_val[0] |= macro_val[1];
-            macro_val[1] = -1;
-          }
-          list_val[0] = -1;
-          list_val[1] = -1;
-          break;
-        case '^':
-          if(macro_val[0] == -1){
-            macro_val[0] = list_val[0] ^ list_val[1];
-          }else if(macro_val[1] == -1 && list_val[1] == -1){
-            macro_val[0] ^= list_val[0];
-          }else if(macro_val[1] == -1 && list_val[1] != -1){
-            macro_val[1] = list_val[0] ^ list_val[1];
-          }else{
-            macro_val[0] ^= macro_val[1];
-            macro_val[1] = -1;
-          }
-          list_val[0] = -1;
-          list_val[1] = -1;
-          break;
-        default:
-          if(list_val[0] == -1){
-            list_val[0] = map[opp[i]];
-          }else if(list_val[1] == -1){
-            list_val[1] = map[opp[i]];
-          }else{
-            std::cout << "WRONG SINTAX: Too many arguments for each operation";
-          }
+    int count = n < 64 ? n : 64;
+    std::memset(inputs.data(), 0, num_of_params * sizeof(word64));
+    for (int i = 0; i < count; i++) {
+      for (int j = 0; j < num_of_params; j++) {
+        inputs[j] |= (word64) infile.read_bit() << i;
       }
     }
-    std::cout << macro_val[0] <<  std::endl;
-    macro_val[0] = -1;
-    macro_val[1] = -1;
-    list_val[0] = -1;
-    list_val[1] = -1;
-    n--;
+    e.evaluate(inputs.data(), results.data());
+    text.clear();
+    format_rows(results.data(), m, count, text);
+    std::cout.write(text.data(), text.size());
+    n -= count;
   }
+  std::cout.flush();
 
     //trata os bichinhos
     return 0;
 }
+
+// Differential check of the JIT against the interpreter on random
+// batches, plus every row when the circuit is small enough.
+static int check_jit(const circuit &compiled) {
+  jit_circuit code(compiled);
+  jit_evaluator native(code);
+  circuit_evaluator interpreted(compiled);
+  int n = compiled.inputs();
+  std::vector<word64> inputs(n);
+  word64 expected;
+  word64 got;
+  std::mt19937_64 random(12345);
+  int batches = 100000;
+  for (int b = 0; b < batches; b++) {
+    for (int j = 0; j < n; j++) {
+      inputs[j] = random();
+    }
+    interpreted.evaluate(inputs.data(), &expected);
+    native.evaluate(inputs.data(), &got);
+    if(expected != got){
+      std::cout << "JIT and interpreter disagree on batch " << b << '\n';
+      return 1;
+    }
+  }
+  if(n <= 24){
+    std::vector<unsigned long long> a = count_ones(interpreted);
+    std::vector<unsigned long long> c = count_ones(native);
+    if(a != c){
+      std::cout << "JIT and interpreter disagree on the truth table\n";
+      return 1;
+    }
+  }
+  std::cout << "JIT and interpreter agree on " << batches << " random batches"
+            << (n <= 24 ? " and the full truth table" : "") << '\n';
+  return 0;
+}
+
+// "SAT" and one satisfying row, or "UNSAT".
+static std::string describe_satisfy(const bdd_manager &m, int f, int inputs) {
+  std::ostringstream oss;
+  std::vector<int> row;
+  if(!m.satisfy(f, row)){
+    return "UNSAT";
+  }
+  oss << "SAT";
+  for(std::vector<int>::size_type j = 0; j != row.size(); j++) {
+    oss << ' ' << row[j];
+  }
+  oss << std::fixed << std::setprecision(0) << " (" << m.count(f) << " of "
+      << std::ldexp(1.0L, inputs) << " rows)";
+  return oss.str();
+}
+
+// f against g: "EQUIVALENT", or "DIFFERENT" and a row where they differ.
+static std::string describe_equivalent(bdd_manager &m, int f, int g, int inputs) {
+  int difference = m.apply(bdd_manager::XOR, f, g);
+  if(difference == 0){
+    return "EQUIVALENT";
+  }
+  std::string sat = describe_satisfy(m, difference, inputs);
+  return "DIFFERENT" + sat.substr(3);
+}
+
+// --satisfy or --equivalent on a single expression.
+static int analyze(const circuit &compiled, const std::string &mode, const std::string &other) {
+  bdd_manager m(compiled.inputs(), BDD_NODE_LIMIT);
+  int f = build_bdd(m, compiled);
+  if(mode == "--satisfy"){
+    std::cout << describe_satisfy(m, f, compiled.inputs()) << '\n';
+  }else{
+    circuit second(compiled.get_symbols(), other);
+    std::cout << describe_equivalent(m, f, build_bdd(m, second), compiled.inputs()) << '\n';
+  }
+  return 0;
+}
+
+// Netlist version: --satisfy checks every output, --equivalent compares
+// the first output with an expression over the netlist's signals.
+static int analyze(netlist &net, const std::string &mode, const std::string &other) {
+  if(mode == "--equivalent"){
+    net.define("__equivalent", other);
+    net.add_output("__equivalent");
+    net.finish();
+  }
+  bdd_manager m(net.inputs(), BDD_NODE_LIMIT);
+  std::vector<int> outputs = build_bdds(m, net);
+  if(mode == "--satisfy"){
+    for (int k = 0; k < net.num_outputs(); k++) {
+      std::cout << net.output_name(k) << ": " << describe_satisfy(m, outputs[k], net.inputs()) << '\n';
+    }
+  }else{
+    std::cout << describe_equivalent(m, outputs[0], outputs.back(), net.inputs()) << '\n';
+  }
+  return 0;
+}
+
+static int run(tokenizer &infile, evaluator &e, const std::string &mode, int threads) {
+  if(mode == "--truth-table"){
+    print_truth_table(e, std::cout);
+  }else if(mode == "--count"){
+    std::vector<unsigned long long> ones = count_ones(e);
+    for(std::vector<unsigned long long>::size_type k = 0; k != ones.size(); k++) {
+      std::cout << ones[k] << (k + 1 < ones.size() ? " " : "\n");
+    }
+  }else{
+    return evaluate(infile, e, threads);
+  }
+  return 0;
+}
+
+int main(int argc, char const *argv[]) {
+  const char *input = "in.txt";
+  std::string mode;
+  int threads = 0;
+  std::string engine = "interpreter";
+  std::string other; // expression for --equivalent
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    if(arg == "--truth-table" || arg == "--count"){
+      mode = arg;
+    }else if(arg == "--check-jit" || arg == "--satisfy"){
+      mode = arg;
+    }else if(arg == "--equivalent" && i + 1 < argc){
+      mode = arg;
+      other = argv[++i];
+    }else if(arg == "--engine" && i + 1 < argc && (std::string(argv[i + 1]) == "jit" ||
+                                                  std::string(argv[i + 1]) == "interpreter")){
+      engine = argv[++i];
+    }else if(arg == "--threads" && i + 1 < argc){
+      threads = std::atoi(argv[++i]);
+    }else if(arg[0] == '-'){
+      std::cerr << "usage: " << argv[0] << " [--truth-table | --count | --check-jit | --satisfy"
+                << " | --equivalent EXPR]"
+                << " [--engine interpreter|jit] [--threads N] [input]\n";
+      return 1;
+    }else{
+      input = argv[i];
+    }
+  }
+  try {
+    tokenizer infile(input);
+    // Either "netlist" or the number of parameters of a single expression.
+    std::string first;
+    infile.read_word(first);
+    if(first == "netlist"){
+      if(engine == "jit" || mode == "--check-jit"){
+        infile.fail("the JIT only compiles single expressions");
+      }
+      netlist net;
+      read_netlist(infile, net);
+      if(mode == "--satisfy" || mode == "--equivalent"){
+        return analyze(net, mode, other);
+      }
+      netlist_evaluator e(net);
+      return run(infile, e, mode, threads);
+    }
+    char *end;
+    long num_of_params = std::strtol(first.c_str(), &end, 10);
+    if(*end != '\0' || num_of_params < 0){
+      infile.fail("expected the number of parameters or 'netlist'");
+    }
+    circuit compiled = read_circuit(infile, num_of_params);
+    if(mode == "--check-jit"){
+      return check_jit(compiled);
+    }
+    if(mode == "--satisfy" || mode == "--equivalent"){
+      return analyze(compiled, mode, other);
+    }
+    if(engine == "jit"){
+      jit_circuit code(compiled);
+      jit_evaluator e(code);
+      return run(infile, e, mode, threads);
+    }
+    circuit_evaluator e(compiled);
+    return run(infile, e, mode, threads);
+  } catch (const std::runtime_error &e) {
+    std::cerr << e.what() << '\n';
+    return 1;
+  }
+}
@@ -0,0 +1,51 @@
+#include "evaluator.hxx"
+
+//Circuit
+circuit_evaluator::circuit_evaluator(const circuit &c)
+  : c(&c), stack(c.depth()), wide_stack(c.depth()) {
+}
+
+int circuit_evaluator::inputs() const {
+  return c->inputs();
+}
+
+int circuit_evaluator::outputs() const {
+  return 1;
+}
+
+void circuit_evaluator::evaluate(const word64 *in, word64 *out) {
+  out[0] = c->evaluate_sliced(in, stack.data());
+}
+
+void circuit_evaluator::evaluate(const word512 *in, word512 *out) {
+  out[0] = c->evaluate_sliced(in, wide_stack.data());
+}
+
+evaluator *circuit_evaluator::clone() const {
+  return new circuit_evaluator(*c);
+}
+
+//Netlist
+netlist_evaluator::netlist_evaluator(const netlist &net)
+  : net(&net), values(net.num_gates()), wide_values(net.num_gates()) {
+}
+
+int netlist_evaluator::inputs() const {
+  return net->inputs();
+}
+
+int netlist_evaluator::outputs() const {
+  return net->num_outputs();
+}
+
+void netlist_evaluator::evaluate(const word64 *in, word64 *out) {
+  net->evaluate_sliced(in, values.data(), out);
+}
+
+void netlist_evaluator::evaluate(const word512 *in, word512 *out) {
+  net->evaluate_sliced(in, wide_values.data(), out);
+}
+
+evaluator *netlist_evaluator::clone() const {
+  return new netlist_evaluator(*net);
+}
@@ -0,0 +1,54 @@
+#ifndef EVALUATOR_HXX
+#define EVALUATOR_HXX
+
+#include "circuit.hxx"
+#include "netlist.hxx"
+#include <vector>
+
+// Common interface of the engines: one call evaluates a batch of
+// bit-sliced rows (64 per word64, 512 per word512). in has inputs() words
+// and out receives outputs() words. Evaluators keep their own scratch
+// space, so each thread needs its own clone().
+class evaluator {
+public:
+  virtual ~evaluator() {}
+  virtual int inputs() const = 0;
+  virtual int outputs() const = 0;
+  virtual void evaluate(const word64 *in, word64 *out) = 0;
+  virtual void evaluate(const word512 *in, word512 *out) = 0;
+  virtual evaluator *clone() const = 0;
+};
+
+// Interprets a single compiled postfix expression.
+class circuit_evaluator : public evaluator {
+private:
+  const circuit *c;
+  std::vector<word64> stack;
+  std::vector<word512> wide_stack;
+
+public:
+  circuit_evaluator(const circuit &c);
+  int inputs() const;
+  int outputs() const;
+  void evaluate(const word64 *in, word64 *out);
+  void evaluate(const word512 *in, word512 *out);
+  evaluator *clone() const;
+};
+
+// Evaluates every needed gate of a netlist once per batch.
+class netlist_evaluator : public evaluator {
+private:
+  const netlist *net;
+  std::vector<word64> values;
+  std::vector<word512> wide_values;
+
+public:
+  netlist_evaluator(const netlist &net);
+  int inputs() const;
+  int outputs() const;
+  void evaluate(const word64 *in, word64 *out);
+  void evaluate(const word512 *in, word512 *out);
+  evaluator *clone() const;
+};
+
+#endif
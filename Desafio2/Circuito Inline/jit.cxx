@@ -0,0 +1,185 @@
+#include "jit.hxx"
+
+#include <stdexcept>
+#include <cstring>
+#include <sys/mman.h>
+
+// Register numbers as the instruction encoding uses them.
+enum {
+  RAX = 0, RCX = 1, RDX = 2, RSP = 4, RSI = 6, RDI = 7,
+  R8 = 8, R9 = 9, R10 = 10, R11 = 11
+};
+
+// Operand stack depth d lives in STACK_REGS[d] for d < 7 and in the
+// spill area at [rsp + 8 * (d - 7)] otherwise. Depth 0 is rax, so the
+// result is already in the return register. r11 is the scratch register.
+static const int STACK_REGS[] = {RAX, RCX, RDX, RSI, R8, R9, R10};
+static const int NUM_STACK_REGS = 7;
+static const int SCRATCH = R11;
+
+// Appends x86-64 machine code; only the handful of forms the circuit
+// compiler needs.
+class assembler {
+public:
+  std::vector<unsigned char> code;
+
+  void byte(int b) {
+    code.push_back(b);
+  }
+  void int32(int v) {
+    for (int i = 0; i < 4; i++) {
+      byte((v >> (8 * i)) & 0xff);
+    }
+  }
+  void rex(int reg, int rm) {
+    byte(0x48 | ((reg >> 3) << 2) | (rm >> 3));
+  }
+  // modrm for [base + disp32]; rsp as a base needs a SIB byte.
+  void memory(int reg, int base, int disp) {
+    byte(0x80 | ((reg & 7) << 3) | (base & 7));
+    if((base & 7) == RSP){
+      byte(0x24);
+    }
+    int32(disp);
+  }
+  // op reg, [base + disp]
+  void load(int opcode, int reg, int base, int disp) {
+    rex(reg, base);
+    byte(opcode);
+    memory(reg, base, disp);
+  }
+  // mov [base + disp], reg
+  void store(int reg, int base, int disp) {
+    rex(reg, base);
+    byte(0x89);
+    memory(reg, base, disp);
+  }
+  // op dst, src with both in registers (the "r/m, r" form)
+  void reg_reg(int opcode, int dst, int src) {
+    rex(src, dst);
+    byte(opcode);
+    byte(0xc0 | ((src & 7) << 3) | (dst & 7));
+  }
+  void adjust_rsp(int opcode_ext, int bytes) {
+    byte(0x48);
+    byte(0x81);
+    byte(0xc0 | (opcode_ext << 3) | RSP);
+    int32(bytes);
+  }
+};
+
+// Opcodes: "r/m, r" form for register destinations, "r, r/m" form to
+// combine with a memory operand.
+static const int MOV_LOAD = 0x8b;
+struct logic_opcodes {
+  int reg_reg;
+  int reg_mem;
+  int mem_reg;
+};
+static const logic_opcodes AND_OPS = {0x21, 0x23, 0x21};
+static const logic_opcodes OR_OPS = {0x09, 0x0b, 0x09};
+static const logic_opcodes XOR_OPS = {0x31, 0x33, 0x31};
+
+static int spill_offset(int depth) {
+  return 8 * (depth - NUM_STACK_REGS);
+}
+
+//Constructor/Destructor
+jit_circuit::jit_circuit(const circuit &c) {
+#if !defined(__x86_64__)
+  throw std::runtime_error("the JIT backend only generates x86-64 code");
+#endif
+  num_inputs = c.inputs();
+  int spills = c.depth() > NUM_STACK_REGS ? c.depth() - NUM_STACK_REGS : 0;
+  int frame = 8 * spills;
+
+  assembler a;
+  if(frame){
+    a.adjust_rsp(5, frame); // sub rsp, frame
+  }
+  const std::vector<instruction> &code = c.get_code();
+  int top = -1;
+  for(std::vector<instruction>::size_type i = 0; i != code.size(); i++) {
+    const instruction &ins = code[i];
+    if(ins.op == OP_LOAD){
+      top++;
+      if(top < NUM_STACK_REGS){
+        a.load(MOV_LOAD, STACK_REGS[top], RDI, 8 * ins.slot);
+      }else{
+        a.load(MOV_LOAD, SCRATCH, RDI, 8 * ins.slot);
+        a.store(SCRATCH, RSP, spill_offset(top));
+      }
+      continue;
+    }
+    const logic_opcodes &ops = ins.op == OP_AND ? AND_OPS : ins.op == OP_OR ? OR_OPS : XOR_OPS;
+    int dst = top - 1;
+    if(top < NUM_STACK_REGS){
+      a.reg_reg(ops.reg_reg, STACK_REGS[dst], STACK_REGS[top]);
+    }else if(dst < NUM_STACK_REGS){
+      a.load(ops.reg_mem, STACK_REGS[dst], RSP, spill_offset(top));
+    }else{
+      a.load(MOV_LOAD, SCRATCH, RSP, spill_offset(top));
+      a.rex(SCRATCH, RSP);
+      a.byte(ops.mem_reg);
+      a.memory(SCRATCH, RSP, spill_offset(dst));
+    }
+    top--;
+  }
+  if(frame){
+    a.adjust_rsp(0, frame); // add rsp, frame
+  }
+  a.byte(0xc3); // ret
+
+  memory_size = a.code.size();
+  memory = mmap(NULL, memory_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if(memory == MAP_FAILED){
+    throw std::runtime_error("could not allocate memory for the JIT");
+  }
+  std::memcpy(memory, a.code.data(), memory_size);
+  if(mprotect(memory, memory_size, PROT_READ | PROT_EXEC) != 0){
+    munmap(memory, memory_size);
+    throw std::runtime_error("could not make the JIT code executable");
+  }
+  entry = (function) memory;
+}
+
+jit_circuit::~jit_circuit() {
+  munmap(memory, memory_size);
+}
+
+int jit_circuit::inputs() const {
+  return num_inputs;
+}
+
+//Evaluator
+jit_evaluator::jit_evaluator(const jit_circuit &code)
+  : code(&code), lanes(code.inputs()) {
+}
+
+int jit_evaluator::inputs() const {
+  return code->inputs();
+}
+
+int jit_evaluator::outputs() const {
+  return 1;
+}
+
+void jit_evaluator::evaluate(const word64 *in, word64 *out) {
+  out[0] = code->evaluate(in);
+}
+
+void jit_evaluator::evaluate(const word512 *in, word512 *out) {
+  const int elements = sizeof(word512) / sizeof(word64);
+  word64 result[elements];
+  for (int e = 0; e < elements; e++) {
+    for (int j = 0; j < code->inputs(); j++) {
+      lanes[j] = in[j][e];
+    }
+    result[e] = code->evaluate(lanes.data());
+  }
+  std::memcpy(&out[0], result, sizeof(result));
+}
+
+evaluator *jit_evaluator::clone() const {
+  return new jit_evaluator(*code);
+}
@@ -0,0 +1,53 @@
+#ifndef JIT_HXX
+#define JIT_HXX
+
+#include "circuit.hxx"
+#include "evaluator.hxx"
+#include <vector>
+
+// Native x86-64 code for one compiled circuit, generated into an
+// executable buffer (no external compiler). The function takes the
+// bit-sliced inputs and returns the 64-row result word. The operand stack
+// lives in registers; only expressions deeper than seven spill to memory.
+class jit_circuit {
+private:
+  typedef word64 (*function)(const word64 *inputs);
+
+  void *memory;
+  size_t memory_size;
+  function entry;
+  int num_inputs;
+
+  jit_circuit(const jit_circuit &);
+  jit_circuit &operator=(const jit_circuit &);
+
+public:
+  // Throws std::runtime_error when the host is not x86-64 or the buffer
+  // cannot be made executable.
+  jit_circuit(const circuit &c);
+  ~jit_circuit();
+
+  int inputs() const;
+
+  word64 evaluate(const word64 *inputs) const {
+    return entry(inputs);
+  }
+};
+
+// The evaluator interface over the generated code; word512 batches are
+// run as eight word64 calls.
+class jit_evaluator : public evaluator {
+private:
+  const jit_circuit *code;
+  std::vector<word64> lanes;
+
+public:
+  jit_evaluator(const jit_circuit &code);
+  int inputs() const;
+  int outputs() const;
+  void evaluate(const word64 *in, word64 *out);
+  void evaluate(const word512 *in, word512 *out);
+  evaluator *clone() const;
+};
+
+#endif
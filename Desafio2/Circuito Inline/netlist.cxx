@@ -0,0 +1,147 @@
+#include "netlist.hxx"
+
+#include <stdexcept>
+
+//Constructor/Destructor
+netlist::netlist() {
+  num_inputs = 0;
+}
+
+netlist::~netlist() {
+}
+
+//Building
+// Returns the existing gate for (op, a, b) or appends a new one. Operands
+// of the commutative operations are ordered so a&b and b&a share a gate.
+int netlist::make(gate_op op, int a, int b) {
+  if(op != GATE_INPUT && a > b){
+    int temp = a;
+    a = b;
+    b = temp;
+  }
+  if((op == GATE_AND || op == GATE_OR) && a == b){
+    return a;
+  }
+  uint64_t key = (uint64_t) op << 62 | (uint64_t) (uint32_t) a << 31 | (uint32_t) b;
+  std::unordered_map<uint64_t, int>::const_iterator it = unique.find(key);
+  if(it != unique.end()){
+    return it->second;
+  }
+  gate g;
+  g.op = op;
+  g.a = a;
+  g.b = b;
+  int id = gates.size();
+  gates.push_back(g);
+  unique[key] = id;
+  return id;
+}
+
+void netlist::add_input(const std::string &name) {
+  if(!gates.empty() && gates.back().op != GATE_INPUT){
+    throw std::runtime_error("WRONG SINTAX: inputs must be declared before gates");
+  }
+  signals.add(name);
+  gate_of_signal.push_back(make(GATE_INPUT, num_inputs, 0));
+  num_inputs++;
+}
+
+void netlist::define(const std::string &name, const std::string &expression) {
+  std::vector<int> stack;
+  std::string::size_type i = 0;
+  while (i < expression.size()) {
+    char c = expression[i];
+    if(c == ' ' || c == '\t'){
+      i++;
+    }else if(c == '&' || c == '|' || c == '^'){
+      if(stack.size() < 2){
+        throw std::runtime_error(std::string("WRONG SINTAX: '") + c + "' needs two arguments in " + name);
+      }
+      int b = stack.back();
+      stack.pop_back();
+      int a = stack.back();
+      stack.pop_back();
+      stack.push_back(make(c == '&' ? GATE_AND : c == '|' ? GATE_OR : GATE_XOR, a, b));
+      i++;
+    }else{
+      std::string::size_type length;
+      int slot = signals.match(expression, i, length);
+      if(slot == -1){
+        throw std::runtime_error("WRONG SINTAX: unknown signal at '" + expression.substr(i) + "' in " + name);
+      }
+      stack.push_back(gate_of_signal[slot]);
+      i += length;
+    }
+  }
+  if(stack.size() != 1){
+    throw std::runtime_error("WRONG SINTAX: " + name + " must be exactly one value");
+  }
+  signals.add(name);
+  gate_of_signal.push_back(stack[0]);
+}
+
+void netlist::add_output(const std::string &name) {
+  int slot = signals.find(name);
+  if(slot == -1){
+    throw std::runtime_error("WRONG SINTAX: unknown output " + name);
+  }
+  outputs.push_back(gate_of_signal[slot]);
+  output_names.push_back(name);
+}
+
+void netlist::finish() {
+  if(outputs.empty()){
+    throw std::runtime_error("WRONG SINTAX: netlist has no outputs");
+  }
+  // Operands have smaller ids, so one backward sweep marks everything
+  // reachable from the outputs.
+  std::vector<char> needed(gates.size(), 0);
+  for(std::vector<int>::size_type k = 0; k != outputs.size(); k++) {
+    needed[outputs[k]] = 1;
+  }
+  for(int id = gates.size() - 1; id >= 0; id--) {
+    if(needed[id] && gates[id].op != GATE_INPUT){
+      needed[gates[id].a] = 1;
+      needed[gates[id].b] = 1;
+    }
+  }
+  schedule.clear();
+  for(std::vector<gate>::size_type id = 0; id != gates.size(); id++) {
+    if(needed[id]){
+      schedule.push_back(id);
+    }
+  }
+}
+
+//Accessors
+int netlist::inputs() const {
+  return num_inputs;
+}
+
+int netlist::num_outputs() const {
+  return outputs.size();
+}
+
+const std::string &netlist::output_name(int k) const {
+  return output_names[k];
+}
+
+int netlist::size() const {
+  return schedule.size();
+}
+
+int netlist::num_gates() const {
+  return gates.size();
+}
+
+const std::vector<gate> &netlist::get_gates() const {
+  return gates;
+}
+
+const std::vector<int> &netlist::get_schedule() const {
+  return schedule;
+}
+
+int netlist::output(int k) const {
+  return outputs[k];
+}
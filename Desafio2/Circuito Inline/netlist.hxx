@@ -0,0 +1,92 @@
+#ifndef NETLIST_HXX
+#define NETLIST_HXX
+
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <cstdint>
+
+#include "symbol_table.hxx"
+
+enum gate_op {
+  GATE_INPUT, // a is the input slot
+  GATE_AND,
+  GATE_OR,
+  GATE_XOR
+};
+
+struct gate {
+  gate_op op;
+  int a;
+  int b;
+};
+
+// Named gates and several outputs built into one DAG. Gates are
+// hash-consed: the same operation on the same operands (in either order)
+// is created once, however many definitions spell it out, so a shared
+// partial term is computed once per row batch. Operands always exist
+// before the gates that use them, so gate order is a topological order.
+class netlist {
+private:
+  std::vector<gate> gates;
+  std::unordered_map<uint64_t, int> unique;
+  symbol_table signals;
+  std::vector<int> gate_of_signal;
+  int num_inputs;
+  std::vector<int> outputs;
+  std::vector<std::string> output_names;
+  std::vector<int> schedule; // gates the outputs depend on, in order
+
+  int make(gate_op op, int a, int b);
+
+public:
+  netlist();
+  ~netlist();
+
+  // All throw std::runtime_error on bad names or expressions.
+  void add_input(const std::string &name);
+  // name = postfix expression over inputs and earlier gates.
+  void define(const std::string &name, const std::string &expression);
+  void add_output(const std::string &name);
+  // Keeps only the gates some output needs; call before evaluating.
+  void finish();
+
+  int inputs() const;
+  int num_outputs() const;
+  const std::string &output_name(int k) const;
+  // Distinct gates evaluated per batch, inputs included.
+  int size() const;
+  int num_gates() const;
+  const std::vector<gate> &get_gates() const;
+  const std::vector<int> &get_schedule() const;
+  // Gate that drives output k.
+  int output(int k) const;
+
+  // inputs[slot] packs one input for every lane, values needs
+  // num_gates() words, out receives num_outputs() words.
+  template <typename W>
+  void evaluate_sliced(const W *inputs, W *values, W *out) const {
+    for(std::vector<int>::size_type i = 0; i != schedule.size(); i++) {
+      const gate &g = gates[schedule[i]];
+      switch (g.op) {
+        case GATE_INPUT:
+          values[schedule[i]] = inputs[g.a];
+          break;
+        case GATE_AND:
+          values[schedule[i]] = values[g.a] & values[g.b];
+          break;
+        case GATE_OR:
+          values[schedule[i]] = values[g.a] | values[g.b];
+          break;
+        case GATE_XOR:
+          values[schedule[i]] = values[g.a] ^ values[g.b];
+          break;
+      }
+    }
+    for(std::vector<int>::size_type k = 0; k != outputs.size(); k++) {
+      out[k] = values[outputs[k]];
+    }
+  }
+};
+
+#endif
@@ -0,0 +1,169 @@
+#include "pipeline.hxx"
+
+#include <vector>
+#include <deque>
+#include <map>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <cstring>
+
+// Rows per block handed to a worker: 64 batches of 64 rows.
+static const int BLOCK_ROWS = 4096;
+
+struct block {
+  long long index;
+  int count;
+  std::vector<word64> inputs; // BLOCK_ROWS / 64 batches of inputs() words
+  std::string text;
+};
+
+// Everything the stages share, guarded by one mutex. Blocks are recycled
+// through free_blocks, so the steady state does not allocate.
+struct pipeline_state {
+  std::mutex mutex;
+  std::condition_variable changed;
+  std::vector<block *> free_blocks;
+  std::deque<block *> parsed;
+  std::map<long long, block *> evaluated;
+  bool reading_done;
+  long long total_blocks;
+
+  pipeline_state() : reading_done(false), total_blocks(-1) {}
+};
+
+void format_rows(const word64 *results, int outputs, int count, std::string &text) {
+  for (int i = 0; i < count; i++) {
+    for (int k = 0; k < outputs; k++) {
+      text += '0' + ((results[k] >> i) & 1);
+      text += k + 1 < outputs ? ' ' : '\n';
+    }
+  }
+}
+
+static void worker(pipeline_state &s, const evaluator &prototype) {
+  evaluator *e = prototype.clone();
+  int n = e->inputs();
+  std::vector<word64> results(e->outputs());
+  while (true) {
+    block *b;
+    {
+      std::unique_lock<std::mutex> lock(s.mutex);
+      while (s.parsed.empty() && !s.reading_done) {
+        s.changed.wait(lock);
+      }
+      if(s.parsed.empty()){
+        break;
+      }
+      b = s.parsed.front();
+      s.parsed.pop_front();
+    }
+    b->text.clear();
+    for (int first = 0; first < b->count; first += 64) {
+      e->evaluate(&b->inputs[(first / 64) * n], results.data());
+      int count = b->count - first < 64 ? b->count - first : 64;
+      format_rows(results.data(), results.size(), count, b->text);
+    }
+    {
+      std::lock_guard<std::mutex> lock(s.mutex);
+      s.evaluated[b->index] = b;
+    }
+    s.changed.notify_all();
+  }
+  delete e;
+}
+
+static void writer(pipeline_state &s, std::ostream &out) {
+  for (long long next = 0; ; next++) {
+    block *b;
+    {
+      std::unique_lock<std::mutex> lock(s.mutex);
+      while (s.evaluated.count(next) == 0 && (s.total_blocks < 0 || next < s.total_blocks)) {
+        s.changed.wait(lock);
+      }
+      if(s.total_blocks >= 0 && next >= s.total_blocks){
+        break;
+      }
+      b = s.evaluated[next];
+      s.evaluated.erase(next);
+    }
+    out.write(b->text.data(), b->text.size());
+    {
+      std::lock_guard<std::mutex> lock(s.mutex);
+      s.free_blocks.push_back(b);
+    }
+    s.changed.notify_all();
+  }
+  out.flush();
+}
+
+// Tells the workers and the writer that no more blocks will come and
+// waits for them to finish.
+static void finish(pipeline_state &s, std::vector<std::thread> &threads, std::thread &output,
+                   long long total_blocks) {
+  {
+    std::lock_guard<std::mutex> lock(s.mutex);
+    s.reading_done = true;
+    s.total_blocks = total_blocks;
+  }
+  s.changed.notify_all();
+  for(std::vector<std::thread>::size_type t = 0; t != threads.size(); t++) {
+    threads[t].join();
+  }
+  output.join();
+}
+
+void evaluate_pipelined(tokenizer &infile, const evaluator &prototype, long long rows,
+                        int num_threads, std::ostream &out) {
+  if(num_threads < 1){
+    num_threads = 1;
+  }
+  int n = prototype.inputs();
+  pipeline_state s;
+  // Enough blocks in flight to keep every worker and the writer busy.
+  std::vector<block> blocks(4 * num_threads + 2);
+  for(std::vector<block>::size_type i = 0; i != blocks.size(); i++) {
+    blocks[i].inputs.resize((BLOCK_ROWS / 64) * n);
+    s.free_blocks.push_back(&blocks[i]);
+  }
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < num_threads; t++) {
+    threads.push_back(std::thread(worker, std::ref(s), std::cref(prototype)));
+  }
+  std::thread output(writer, std::ref(s), std::ref(out));
+
+  long long index = 0;
+  try {
+    for (long long first = 0; first < rows; first += BLOCK_ROWS, index++) {
+      block *b;
+      {
+        std::unique_lock<std::mutex> lock(s.mutex);
+        while (s.free_blocks.empty()) {
+          s.changed.wait(lock);
+        }
+        b = s.free_blocks.back();
+        s.free_blocks.pop_back();
+      }
+      b->index = index;
+      b->count = rows - first < BLOCK_ROWS ? rows - first : BLOCK_ROWS;
+      std::memset(b->inputs.data(), 0, b->inputs.size() * sizeof(word64));
+      for (int i = 0; i < b->count; i++) {
+        word64 *batch = &b->inputs[(i / 64) * n];
+        for (int j = 0; j < n; j++) {
+          batch[j] |= (word64) infile.read_bit() << (i % 64);
+        }
+      }
+      {
+        std::lock_guard<std::mutex> lock(s.mutex);
+        s.parsed.push_back(b);
+      }
+      s.changed.notify_all();
+    }
+  } catch (...) {
+    // Let the other stages drain what was read, then report the error.
+    finish(s, threads, output, index);
+    throw;
+  }
+  finish(s, threads, output, index);
+}
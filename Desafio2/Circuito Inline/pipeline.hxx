@@ -0,0 +1,20 @@
+#ifndef PIPELINE_HXX
+#define PIPELINE_HXX
+
+#include "evaluator.hxx"
+#include "tokenizer.hxx"
+#include <ostream>
+#include <string>
+
+// Appends the outputs of count rows of one 64-row batch to text, one row
+// per line, outputs separated by blanks.
+void format_rows(const word64 *results, int outputs, int count, std::string &text);
+
+// Evaluates the next rows rows of infile in three stages: this thread
+// parses blocks of rows, num_threads workers evaluate them with their own
+// clones of prototype, and a writer thread prints the blocks in input
+// order through large writes.
+void evaluate_pipelined(tokenizer &infile, const evaluator &prototype, long long rows,
+                        int num_threads, std::ostream &out);
+
+#endif
@@ -0,0 +1,54 @@
+#include "symbol_table.hxx"
+
+#include <stdexcept>
+
+//Constructor/Destructor
+symbol_table::symbol_table() {
+  longest = 0;
+}
+
+symbol_table::~symbol_table() {
+}
+
+//Declaration
+int symbol_table::add(const std::string &name) {
+  if(name.empty() || name.find_first_of("&|^ \t") != std::string::npos){
+    throw std::runtime_error("WRONG SINTAX: invalid variable name '" + name + "'");
+  }
+  if(index.count(name)){
+    throw std::runtime_error("WRONG SINTAX: variable '" + name + "' declared twice");
+  }
+  int slot = names.size();
+  names.push_back(name);
+  index[name] = slot;
+  if(name.size() > longest){
+    longest = name.size();
+  }
+  return slot;
+}
+
+//Lookup
+int symbol_table::find(const std::string &name) const {
+  std::unordered_map<std::string, int>::const_iterator it = index.find(name);
+  return it == index.end() ? -1 : it->second;
+}
+
+int symbol_table::match(const std::string &text, std::string::size_type pos,
+                        std::string::size_type &length) const {
+  std::string::size_type max = text.size() - pos < longest ? text.size() - pos : longest;
+  for (length = max; length > 0; length--) {
+    int slot = find(text.substr(pos, length));
+    if(slot != -1){
+      return slot;
+    }
+  }
+  return -1;
+}
+
+int symbol_table::size() const {
+  return names.size();
+}
+
+const std::string &symbol_table::name(int slot) const {
+  return names[slot];
+}
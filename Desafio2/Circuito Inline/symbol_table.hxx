@@ -0,0 +1,33 @@
+#ifndef SYMBOL_TABLE_HXX
+#define SYMBOL_TABLE_HXX
+
+#include <vector>
+#include <string>
+#include <unordered_map>
+
+// Maps signal names to dense slots 0..size()-1, in declaration order.
+// Only used while compiling: the evaluators index flat arrays by slot.
+class symbol_table {
+private:
+  std::vector<std::string> names;
+  std::unordered_map<std::string, int> index;
+  std::string::size_type longest;
+
+public:
+  symbol_table();
+  ~symbol_table();
+
+  // Throws std::runtime_error for duplicate or invalid names.
+  int add(const std::string &name);
+  // Slot of name, -1 when it was never declared.
+  int find(const std::string &name) const;
+  // Longest declared name starting at text[pos]; returns its slot and
+  // sets length, or returns -1.
+  int match(const std::string &text, std::string::size_type pos,
+            std::string::size_type &length) const;
+
+  int size() const;
+  const std::string &name(int slot) const;
+};
+
+#endif
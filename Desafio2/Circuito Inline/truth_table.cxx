@@ -0,0 +1,88 @@
+#include "truth_table.hxx"
+
+#include <cstring>
+#include <stdexcept>
+
+// Bit i of PATTERN[b] is bit b of i: the low six row bits inside a word.
+static const uint64_t PATTERN[6] = {
+  0xAAAAAAAAAAAAAAAAULL, 0xCCCCCCCCCCCCCCCCULL, 0xF0F0F0F0F0F0F0F0ULL,
+  0xFF00FF00FF00FF00ULL, 0xFFFF0000FFFF0000ULL, 0xFFFFFFFF00000000ULL
+};
+
+// Lanes of W hold rows base, base + 1, ...; element e of the word covers
+// rows base + 64e .. base + 64e + 63. base must be a multiple of the lanes.
+template <typename W>
+static void fill_inputs(int n, unsigned long long base, W *inputs) {
+  const int elements = sizeof(W) / sizeof(uint64_t);
+  uint64_t lanes[elements];
+  for (int j = 0; j < n; j++) {
+    int bit = n - 1 - j;
+    for (int e = 0; e < elements; e++) {
+      if(bit < 6){
+        lanes[e] = PATTERN[bit];
+      }else{
+        unsigned long long row = base + 64ULL * e;
+        lanes[e] = (row >> bit) & 1 ? ~0ULL : 0;
+      }
+    }
+    std::memcpy(&inputs[j], lanes, sizeof(W));
+  }
+}
+
+static void check_size(const evaluator &e) {
+  if(e.inputs() > 62){
+    throw std::runtime_error("truth table needs fewer than 63 inputs");
+  }
+}
+
+void print_truth_table(evaluator &e, std::ostream &out) {
+  check_size(e);
+  int n = e.inputs();
+  int m = e.outputs();
+  unsigned long long rows = 1ULL << n;
+  std::vector<word64> inputs(n);
+  std::vector<word64> results(m);
+  std::vector<char> text(64 * 2 * m);
+  out << rows << '\n';
+  for(unsigned long long base = 0; base < rows; base += 64) {
+    fill_inputs(n, base, inputs.data());
+    e.evaluate(inputs.data(), results.data());
+    int count = rows - base < 64 ? rows - base : 64;
+    char *p = text.data();
+    for (int i = 0; i < count; i++) {
+      for (int k = 0; k < m; k++) {
+        *p++ = '0' + ((results[k] >> i) & 1);
+        *p++ = k + 1 < m ? ' ' : '\n';
+      }
+    }
+    out.write(text.data(), p - text.data());
+  }
+}
+
+std::vector<unsigned long long> count_ones(evaluator &e) {
+  check_size(e);
+  int n = e.inputs();
+  int m = e.outputs();
+  unsigned long long rows = 1ULL << n;
+  const int elements = sizeof(word512) / sizeof(uint64_t);
+  std::vector<word512> inputs(n);
+  std::vector<word512> results(m);
+  std::vector<unsigned long long> ones(m, 0);
+  for(unsigned long long base = 0; base < rows; base += 64 * elements) {
+    fill_inputs(n, base, inputs.data());
+    e.evaluate(inputs.data(), results.data());
+    for (int k = 0; k < m; k++) {
+      uint64_t lanes[elements];
+      std::memcpy(lanes, &results[k], sizeof(lanes));
+      for (int l = 0; l < elements; l++) {
+        unsigned long long first = base + 64ULL * l;
+        if(first >= rows){
+          break;
+        }
+        uint64_t valid = rows - first < 64 ? (1ULL << (rows - first)) - 1 : ~0ULL;
+        ones[k] += __builtin_popcountll(lanes[l] & valid);
+      }
+    }
+  }
+  return ones;
+}
@@ -0,0 +1,17 @@
+#ifndef TRUTH_TABLE_HXX
+#define TRUTH_TABLE_HXX
+
+#include "evaluator.hxx"
+#include <ostream>
+#include <vector>
+
+// Generates every input row itself instead of reading them: row r assigns
+// the first input the most significant bit of r, as in.txt lists them.
+
+// Prints 2^n followed by the outputs of each row, one row per line.
+void print_truth_table(evaluator &e, std::ostream &out);
+
+// Number of rows where each output is 1, evaluated 512 rows per word.
+std::vector<unsigned long long> count_ones(evaluator &e);
+
+#endif
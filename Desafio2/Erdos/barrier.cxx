@@ -0,0 +1,26 @@
+#include "barrier.hxx"
+
+//Constructor/Destructor
+barrier::barrier(int count) {
+  this->count = count;
+  waiting = 0;
+  generation = 0;
+}
+
+barrier::~barrier() {
+}
+
+//Wait
+void barrier::wait() {
+  std::unique_lock<std::mutex> lock(mutex);
+  unsigned long my_generation = generation;
+  if(++waiting == count){
+    waiting = 0;
+    generation++;
+    cond.notify_all();
+  }else{
+    while (my_generation == generation) {
+      cond.wait(lock);
+    }
+  }
+}
@@ -0,0 +1,22 @@
+#ifndef BARRIER_HXX
+#define BARRIER_HXX
+
+#include <mutex>
+#include <condition_variable>
+
+// Reusable barrier for a fixed number of threads (C++11 has none).
+class barrier {
+private:
+  std::mutex mutex;
+  std::condition_variable cond;
+  int count;
+  int waiting;
+  unsigned long generation;
+
+public:
+  barrier(int count);
+  ~barrier();
+  void wait();
+};
+
+#endif
@@ -0,0 +1,122 @@
+#include "bfs.hxx"
+#include "bitmap.hxx"
+
+void bfs(const graph &g, int source, std::vector<int> &distance) {
+  distance.assign(g.size(), -1);
+  // The frontier lives in one array: [head, tail) is the current queue.
+  std::vector<int> queue(g.size());
+  int head = 0;
+  int tail = 0;
+  queue[tail++] = source;
+  distance[source] = 0;
+  while (head < tail) {
+    int v = queue[head++];
+    int next_distance = distance[v] + 1;
+    for(const int *it = g.begin(v); it != g.end(v); it++) {
+      if(distance[*it] == -1){
+        distance[*it] = next_distance;
+        queue[tail++] = *it;
+      }
+    }
+  }
+}
+
+// Switching thresholds from Beamer et al.: go bottom-up once the frontier
+// has more than 1/ALPHA of the unexplored edges, come back top-down once
+// it holds fewer than 1/BETA of the vertices and is shrinking.
+static const int ALPHA = 15;
+static const int BETA = 18;
+
+static long long top_down_step(const graph &g, std::vector<int> &distance, bitmap &visited,
+                               std::vector<int> &frontier, std::vector<int> &next) {
+  long long scout = 0; // edges leaving the new frontier
+  next.clear();
+  for(std::vector<int>::size_type i = 0; i != frontier.size(); i++) {
+    int v = frontier[i];
+    int next_distance = distance[v] + 1;
+    for(const int *it = g.begin(v); it != g.end(v); it++) {
+      if(!visited.test(*it)){
+        visited.set(*it);
+        distance[*it] = next_distance;
+        next.push_back(*it);
+        scout += g.degree(*it);
+      }
+    }
+  }
+  frontier.swap(next);
+  return scout;
+}
+
+static int bottom_up_step(const graph &g, std::vector<int> &distance, bitmap &visited,
+                          bitmap &front, bitmap &next, int level, long long &scout) {
+  int awake = 0; // vertices added to the new frontier
+  scout = 0; // edges leaving them
+  next.clear();
+  for(int v = 0; v < g.size(); v++) {
+    if(visited.test(v)){
+      continue;
+    }
+    for(const int *it = g.begin(v); it != g.end(v); it++) {
+      if(front.test(*it)){
+        visited.set(v);
+        distance[v] = level + 1;
+        next.set(v);
+        awake++;
+        scout += g.degree(v);
+        break;
+      }
+    }
+  }
+  front.swap(next);
+  return awake;
+}
+
+void bfs_direction_optimizing(const graph &g, int source, std::vector<int> &distance) {
+  int n = g.size();
+  distance.assign(n, -1);
+  bitmap visited(n);
+  bitmap front(n);
+  bitmap next_front(n);
+  std::vector<int> frontier;
+  std::vector<int> next;
+  frontier.reserve(n);
+  next.reserve(n);
+
+  visited.set(source);
+  distance[source] = 0;
+  frontier.push_back(source);
+  long long scout = g.degree(source);
+  // Edge ends not yet looked at: a frontier's edges count as explored
+  // once that frontier is expanded, whichever direction it goes.
+  long long unexplored = 2 * g.num_edges();
+  int level = 0;
+
+  while (!frontier.empty()) {
+    if(scout > unexplored / ALPHA){
+      // Queue -> bitmap, then sweep bottom-up until the frontier shrinks.
+      front.clear();
+      for(std::vector<int>::size_type i = 0; i != frontier.size(); i++) {
+        front.set(frontier[i]);
+      }
+      int awake = frontier.size();
+      int old_awake;
+      do {
+        unexplored -= scout;
+        old_awake = awake;
+        awake = bottom_up_step(g, distance, visited, front, next_front, level, scout);
+        level++;
+      } while (awake >= old_awake || awake > n / BETA);
+      // Bitmap -> queue for the top-down steps; scout already covers it.
+      frontier.clear();
+      for(int v = 0; v < n; v++) {
+        if(front.test(v)){
+          frontier.push_back(v);
+        }
+      }
+    }else{
+      unexplored -= scout;
+      scout = top_down_step(g, distance, visited, frontier, next);
+      level++;
+    }
+  }
+}
@@ -0,0 +1,24 @@
+#ifndef BFS_HXX
+#define BFS_HXX
+
+#include "graph.hxx"
+#include <vector>
+
+// Distance of every vertex from source, -1 when unreachable.
+void bfs(const graph &g, int source, std::vector<int> &distance);
+
+// Same result as bfs(), but switches to bottom-up sweeps (every unvisited
+// vertex looks for a parent in the frontier) while the frontier is large.
+void bfs_direction_optimizing(const graph &g, int source, std::vector<int> &distance);
+
+// Level-synchronous BFS over num_threads threads. Distances are claimed
+// with compare-and-swap, so the result is identical to bfs().
+void bfs_parallel(const graph &g, int source, std::vector<int> &distance, int num_threads);
+
+// Distances from many sources at once: distances[i][v] is the distance
+// from sources[i] to v. Sources are searched 64 at a time, one bit each,
+// so every adjacency scan serves the whole batch.
+void bfs_multi_source(const graph &g, const std::vector<int> &sources,
+                      std::vector<std::vector<int> > &distances);
+
+#endif
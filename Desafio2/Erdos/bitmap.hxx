@@ -0,0 +1,30 @@
+#ifndef BITMAP_HXX
+#define BITMAP_HXX
+
+#include <vector>
+#include <cstdint>
+
+// One bit per vertex; the hot accessors are inline so the BFS loops
+// compile down to a shift and a mask.
+class bitmap {
+private:
+  std::vector<uint64_t> words;
+
+public:
+  bitmap(int size) : words((size + 63) / 64, 0) {}
+
+  bool test(int i) const {
+    return (words[i >> 6] >> (i & 63)) & 1;
+  }
+  void set(int i) {
+    words[i >> 6] |= uint64_t(1) << (i & 63);
+  }
+  void clear() {
+    words.assign(words.size(), 0);
+  }
+  void swap(bitmap &other) {
+    words.swap(other.words);
+  }
+};
+
+#endif
@@ -0,0 +1,155 @@
+#include "dynamic_distance.hxx"
+#include "bfs.hxx"
+
+#include <queue>
+#include <functional>
+
+//Constructor/Destructor
+dynamic_distance::dynamic_distance(const graph &g, int source) {
+  this->source = source;
+  adjacency.resize(g.size());
+  for(int v = 0; v < g.size(); v++) {
+    adjacency[v].assign(g.begin(v), g.end(v));
+  }
+  bfs(g, source, distance);
+  invalid.assign(g.size(), 0);
+}
+
+dynamic_distance::~dynamic_distance() {
+}
+
+//Distance
+int dynamic_distance::size() const {
+  return adjacency.size();
+}
+
+int dynamic_distance::get_distance(int v) const {
+  return distance[v];
+}
+
+const std::vector<int> &dynamic_distance::get_distances() const {
+  return distance;
+}
+
+//Insertion
+// BFS that only follows vertices whose distance just got smaller.
+void dynamic_distance::propagate(int start) {
+  queue.clear();
+  queue.push_back(start);
+  for(std::vector<int>::size_type head = 0; head != queue.size(); head++) {
+    int v = queue[head];
+    int next_distance = distance[v] + 1;
+    for(std::vector<int>::size_type i = 0; i != adjacency[v].size(); i++) {
+      int w = adjacency[v][i];
+      if(distance[w] == -1 || next_distance < distance[w]){
+        distance[w] = next_distance;
+        queue.push_back(w);
+      }
+    }
+  }
+}
+
+void dynamic_distance::insert_edge(int from, int to) {
+  adjacency[from].push_back(to);
+  adjacency[to].push_back(from);
+  if(distance[from] != -1 && (distance[to] == -1 || distance[from] + 1 < distance[to])){
+    distance[to] = distance[from] + 1;
+    propagate(to);
+  }else if(distance[to] != -1 && (distance[from] == -1 || distance[to] + 1 < distance[from])){
+    distance[from] = distance[to] + 1;
+    propagate(from);
+  }
+}
+
+//Deletion
+void dynamic_distance::remove_adjacency(int from, int to) {
+  std::vector<int> &list = adjacency[from];
+  for(std::vector<int>::size_type i = 0; i != list.size(); i++) {
+    if(list[i] == to){
+      list[i] = list.back();
+      list.pop_back();
+      return;
+    }
+  }
+}
+
+void dynamic_distance::remove_edges(const std::vector<std::pair<int, int> > &edges) {
+  typedef std::pair<int, int> entry; // (distance, vertex)
+  std::priority_queue<entry, std::vector<entry>, std::greater<entry> > candidates;
+
+  // Only the far endpoint of an edge between consecutive levels can lose
+  // its shortest path.
+  for(std::vector<std::pair<int, int> >::size_type i = 0; i != edges.size(); i++) {
+    int from = edges[i].first;
+    int to = edges[i].second;
+    remove_adjacency(from, to);
+    remove_adjacency(to, from);
+    if(distance[from] != -1 && distance[to] == distance[from] + 1){
+      candidates.push(entry(distance[to], to));
+    }else if(distance[to] != -1 && distance[from] == distance[to] + 1){
+      candidates.push(entry(distance[from], from));
+    }
+  }
+
+  // Walk the candidates level by level: a vertex is invalid when no valid
+  // neighbor sits one level closer, and then its children become suspect.
+  std::vector<int> affected;
+  while (!candidates.empty()) {
+    int v = candidates.top().second;
+    candidates.pop();
+    if(invalid[v] || v == source){
+      continue;
+    }
+    bool supported = false;
+    for(std::vector<int>::size_type i = 0; i != adjacency[v].size() && !supported; i++) {
+      int w = adjacency[v][i];
+      supported = !invalid[w] && distance[w] == distance[v] - 1;
+    }
+    if(supported){
+      continue;
+    }
+    invalid[v] = 1;
+    affected.push_back(v);
+    for(std::vector<int>::size_type i = 0; i != adjacency[v].size(); i++) {
+      int w = adjacency[v][i];
+      if(!invalid[w] && distance[w] == distance[v] + 1){
+        candidates.push(entry(distance[w], w));
+      }
+    }
+  }
+
+  // Re-attach the invalid region to the rest of the tree: seed each vertex
+  // from its best valid neighbor, then relax inside the region only.
+  for(std::vector<int>::size_type k = 0; k != affected.size(); k++) {
+    int v = affected[k];
+    distance[v] = -1;
+    for(std::vector<int>::size_type i = 0; i != adjacency[v].size(); i++) {
+      int w = adjacency[v][i];
+      if(!invalid[w] && distance[w] != -1 && (distance[v] == -1 || distance[w] + 1 < distance[v])){
+        distance[v] = distance[w] + 1;
+      }
+    }
+    if(distance[v] != -1){
+      candidates.push(entry(distance[v], v));
+    }
+  }
+  while (!candidates.empty()) {
+    entry top = candidates.top();
+    candidates.pop();
+    int v = top.second;
+    if(top.first != distance[v] || !invalid[v]){
+      continue;
+    }
+    invalid[v] = 0;
+    for(std::vector<int>::size_type i = 0; i != adjacency[v].size(); i++) {
+      int w = adjacency[v][i];
+      if(invalid[w] && (distance[w] == -1 || top.first + 1 < distance[w])){
+        distance[w] = top.first + 1;
+        candidates.push(entry(distance[w], w));
+      }
+    }
+  }
+  for(std::vector<int>::size_type k = 0; k != affected.size(); k++) {
+    invalid[affected[k]] = 0;
+  }
+}
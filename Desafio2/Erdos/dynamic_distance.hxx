@@ -0,0 +1,34 @@
+#ifndef DYNAMIC_DISTANCE_HXX
+#define DYNAMIC_DISTANCE_HXX
+
+#include "graph.hxx"
+#include <vector>
+#include <utility>
+
+// Distances from one source that are kept up to date while edges come and
+// go. Insertions only touch the vertices whose distance improves; a batch
+// of deletions only recomputes the vertices that lost every shortest path.
+class dynamic_distance {
+private:
+  int source;
+  std::vector<std::vector<int> > adjacency;
+  std::vector<int> distance; // -1 when unreachable
+  std::vector<int> queue;
+  std::vector<char> invalid;
+
+  void propagate(int start);
+  void remove_adjacency(int from, int to);
+
+public:
+  dynamic_distance(const graph &g, int source);
+  ~dynamic_distance();
+
+  int size() const;
+  int get_distance(int v) const;
+  const std::vector<int> &get_distances() const;
+
+  void insert_edge(int from, int to);
+  void remove_edges(const std::vector<std::pair<int, int> > &edges);
+};
+
+#endif
@@ -2,79 +2,266 @@
 #include <string>
 #include <sstream>
 #include <vector>
-#include <stack>
+#include <stdexcept>
 #include <fstream>
+#include <cstdlib>
+#include <thread>
 
-#include "node.hxx"
-#include "link.hxx"
+#include "graph.hxx"
+#include "bfs.hxx"
+#include "reader.hxx"
+#include "reorder.hxx"
+#include "dynamic_distance.hxx"
+#include "pair_query.hxx"
+#include "tokenizer.hxx"
 
-int main(int argc, char const *argv[]) {
-  std::ifstream file("in.txt");
-  std::string line; // each line in the file
-  std::stack<node *> not_explored;
-  std::vector<node *> node_list;// list to keep track of nodes
+static void usage(const char *program) {
+  std::cerr << "usage: " << program << " [--mode serial|dobfs|parallel] [--threads N]"
+            << " [--reorder rcm|bfs|degree]"
+            << " [--sources ID,ID,... | --sources-file FILE] [--stream | --serve] [--who NAME]..."
+            << " [input | snapshot]\n";
+}
+
+// Ids as written in the input file versus ids in the graph the traversals
+// run on; they only differ when --reorder renumbered the vertices.
+struct relabeling {
+  std::vector<int> new_id; // empty means identity
+
+  int to_graph(int v) const {
+    return new_id.empty() ? v : new_id[v];
+  }
+};
+
+// Prints in input order, whatever order the graph is stored in.
+static void print_distances(const graph &g, const relabeling &ids, const std::vector<int> &distance) {
+  std::cout << g.size() << '\n';
+  for(int i = 0; i < g.size(); i++) {
+    int v = ids.to_graph(i);
+    std::cout << g.get_name(v) << ": " << distance[v] << '\n';
+  }
+}
+
+// Resolves one side of a query: a numeric input id or an exact author name.
+static int parse_author(const graph &g, const relabeling &ids, const std::string &text) {
+  char *end;
+  long id = std::strtol(text.c_str(), &end, 10);
+  if(!text.empty() && *end == '\0'){
+    return id >= 0 && id < g.size() ? ids.to_graph(id) : -1;
+  }
+  return g.find(text);
+}
 
-  int from, to, n, m;
-  //FILLING IN THE NODES AND LINKS
+// Long-running point-to-point server: each stdin line is either
+// "ID ID" or "NAME<TAB>NAME" and is answered with one distance line.
+static void serve_queries(const graph &g, const relabeling &ids) {
+  pair_query query(g);
+  tokenizer input(0, "stdin");
+  std::string line;
+  while (input.read_line(line)) {
+    if(line.empty()){
+      continue;
+    }
+    std::string::size_type split = line.find('\t');
+    if(split == std::string::npos){
+      split = line.find(' ');
+    }
+    int from = -1;
+    int to = -1;
+    if(split != std::string::npos){
+      from = parse_author(g, ids, line.substr(0, split));
+      to = parse_author(g, ids, line.substr(split + 1));
+    }
+    if(from == -1 || to == -1){
+      std::cout << "error: unknown author in \"" << line << "\"\n";
+    }else{
+      std::cout << query.distance_between(from, to) << '\n';
+    }
+    std::cout.flush();
+  }
+}
 
-  std::getline(file, line);
-  std::istringstream iss(line);
-  iss >> n; // number of people
-  m = n;
-  while(m > 0){
-    std::getline(file, line);
-    node *nd = new node(line);
-    node_list.push_back(nd);
-    m--;
-  }
-  std::getline(file, line);
-  std::istringstream iss2(line);
-  iss2 >> m; // number of connections
-  while(m > 0){
-    std::getline(file, line);
-    std::istringstream iss(line);
-    iss >> from >> to;
-    if(from > to){
-      int temp = from;
-      from = to;
-      to = temp;
+// Reads updates from stdin and keeps the distances from author 0 current:
+//   + FROM TO   new connection
+//   - FROM TO   removed connection (consecutive removals form one batch)
+//   ? ID        print one author's distance
+//   =           print the whole table
+static void stream_updates(const graph &g, const relabeling &ids) {
+  dynamic_distance dynamic(g, ids.to_graph(0));
+  tokenizer input(0, "stdin");
+  std::vector<std::pair<int, int> > removed;
+  while (!input.at_end()) {
+    char op = input.read_char();
+    if(op != '-' && !removed.empty()){
+      dynamic.remove_edges(removed);
+      removed.clear();
+    }
+    if(op == '+' || op == '-'){
+      long long from = input.read_int();
+      long long to = input.read_int();
+      if(from < 0 || from >= g.size() || to < 0 || to >= g.size()){
+        input.fail("connection refers to an unknown person");
+      }
+      if(op == '+'){
+        dynamic.insert_edge(ids.to_graph(from), ids.to_graph(to));
+      }else{
+        removed.push_back(std::make_pair(ids.to_graph(from), ids.to_graph(to)));
+      }
+    }else if(op == '?'){
+      long long v = input.read_int();
+      if(v < 0 || v >= g.size()){
+        input.fail("unknown person");
+      }
+      v = ids.to_graph(v);
+      std::cout << g.get_name(v) << ": " << dynamic.get_distance(v) << '\n';
+    }else if(op == '='){
+      print_distances(g, ids, dynamic.get_distances());
+    }else{
+      input.fail(std::string("unknown update '") + op + "'");
     }
-    link *lk = new link(from, to);
-    node_list[from]->add_link(lk);
-    m--;
+    input.expect_end_of_line();
+    std::cout.flush();
   }
+  if(!removed.empty()){
+    dynamic.remove_edges(removed);
+  }
+}
+
+// Appends the ids in a comma or whitespace separated list to sources.
+static void parse_sources(const std::string &text, std::vector<int> &sources) {
+  std::string list = text;
+  for(std::string::size_type i = 0; i < list.size(); i++) {
+    if(list[i] == ','){
+      list[i] = ' ';
+    }
+  }
+  std::istringstream iss(list);
+  int id;
+  while (iss >> id) {
+    sources.push_back(id);
+  }
+}
+
+int main(int argc, char const *argv[]) {
+  std::string input = "in.txt";
+  std::string mode = "dobfs";
+  std::string order;
+  int threads = std::thread::hardware_concurrency();
+  std::vector<int> sources;
+  bool stream = false;
+  bool serve = false;
+  std::vector<std::string> who;
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    if(arg == "--mode" && i + 1 < argc){
+      mode = argv[++i];
+    }else if(arg == "--threads" && i + 1 < argc){
+      threads = std::atoi(argv[++i]);
+    }else if(arg == "--reorder" && i + 1 < argc){
+      order = argv[++i];
+    }else if(arg == "--sources" && i + 1 < argc){
+      parse_sources(argv[++i], sources);
+    }else if(arg == "--sources-file" && i + 1 < argc){
+      std::ifstream sources_file(argv[++i]);
+      std::stringstream contents;
+      contents << sources_file.rdbuf();
+      parse_sources(contents.str(), sources);
+    }else if(arg == "--who" && i + 1 < argc){
+      who.push_back(argv[++i]);
+    }else if(arg == "--serve"){
+      serve = true;
+    }else if(arg == "--stream"){
+      stream = true;
+    }else if(arg[0] == '-'){
+      usage(argv[0]);
+      return 1;
+    }else{
+      input = arg;
+    }
+  }
+  if(mode != "serial" && mode != "dobfs" && mode != "parallel"){
+    usage(argv[0]);
+    return 1;
+  }
+
+  graph *loaded;
+  relabeling ids;
+  try {
+    loaded = read_graph(input);
+    if(!order.empty()){
+      ids.new_id = reorder(*loaded, order);
+      graph *relabeled = new graph(*loaded, ids.new_id);
+      delete loaded;
+      loaded = relabeled;
+    }
+  } catch (const std::runtime_error &e) {
+    std::cerr << e.what() << '\n';
+    return 1;
+  }
+  const graph &g = *loaded;
+  int n = g.size();
 
   //ALGORITHM
-  std::cout << n << '\n';
-  node *nd;
-  not_explored.push(node_list[0]);
-  node_list[0]->make_a_visit();
-  node_list[0]->set_distance(0);
-  std::vector<link*> node_links;
-  while (!not_explored.empty()) {
-    nd = not_explored.top();
-    not_explored.pop();
-    node_links = nd->get_links();
-    for(std::vector<link*>::size_type j = 0; j != node_links.size(); j++) {
-      node *curr_node = node_list[node_links[j]->get_to()];
-      if(!curr_node->was_visited()){
-        curr_node->make_a_visit();
-        curr_node->set_distance(nd->get_distance()+1);
-        not_explored.push(curr_node);
+  if(stream || serve){
+    try {
+      if(stream){
+        stream_updates(g, ids);
+      }else{
+        serve_queries(g, ids);
       }
+    } catch (const std::runtime_error &e) {
+      std::cerr << e.what() << '\n';
+      delete loaded;
+      return 1;
     }
+    delete loaded;
+    return 0;
   }
-  for(std::vector<node*>::size_type i = 0; i != node_list.size(); i++) {
-    std::vector<link*> links = node_list[i]->get_links();
-    std::cout << node_list[i]->get_name() << ": " << node_list[i]->get_distance() << '\n';
+  for(std::vector<int>::size_type i = 0; i != sources.size(); i++) {
+    if(sources[i] < 0 || sources[i] >= g.size()){
+      std::cerr << "source " << sources[i] << " is not an author id\n";
+      delete loaded;
+      return 1;
+    }
+    sources[i] = ids.to_graph(sources[i]);
+  }
+  if(!sources.empty()){
+    // One column per source, in the order they were given.
+    std::vector<std::vector<int> > distances;
+    bfs_multi_source(g, sources, distances);
+    std::cout << n << '\n';
+    for(int i = 0; i < g.size(); i++) {
+      int v = ids.to_graph(i);
+      std::cout << g.get_name(v) << ':';
+      for(std::vector<int>::size_type k = 0; k != sources.size(); k++) {
+        std::cout << ' ' << distances[k][v];
+      }
+      std::cout << '\n';
+    }
+    delete loaded;
+    return 0;
+  }
+
+  std::vector<int> distance;
+  int source = ids.to_graph(0);
+  if(mode == "serial"){
+    bfs(g, source, distance);
+  }else if(mode == "dobfs"){
+    bfs_direction_optimizing(g, source, distance);
+  }else{
+    bfs_parallel(g, source, distance, threads);
   }
+
+  if(who.empty()){
+    print_distances(g, ids, distance);
+  }
+  for(std::vector<std::string>::size_type i = 0; i != who.size(); i++) {
+    int id = g.find(who[i]);
+    if(id == -1){
+      std::cout << who[i] << ": unknown author\n";
+    }else{
+      std::cout << who[i] << ": " << distance[id] << '\n';
+    }
+  }
+  delete loaded;
   return 0;
 }
-
-// for(std::vector<node*>::size_type i = 0; i != node_list.size(); i++) {
-//   std::vector<link*> links = node_list[i]->get_links();
-//   std::cout << node_list[i]->get_name() << ", " << i << '\n';
-//   for(std::vector<link*>::size_type j = 0; j != links.size(); j++) {
-//     std::cout << links[j]->get_from() <<','<<links[j]->get_to()<< '\n';
-//   }
-// }
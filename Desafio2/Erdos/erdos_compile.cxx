@@ -0,0 +1,23 @@
+#include <iostream>
+#include <stdexcept>
+
+#include "graph.hxx"
+#include "reader.hxx"
+
+// Converts the text input into a binary snapshot that erdos maps directly.
+int main(int argc, char const *argv[]) {
+  if(argc != 3){
+    std::cerr << "usage: " << argv[0] << " input.txt output.bin\n";
+    return 1;
+  }
+  try {
+    graph *g = read_graph(argv[1]);
+    g->save_snapshot(argv[2]);
+    std::cerr << g->size() << " authors, " << g->num_edges() << " connections\n";
+    delete g;
+  } catch (const std::runtime_error &e) {
+    std::cerr << e.what() << '\n';
+    return 1;
+  }
+  return 0;
+}
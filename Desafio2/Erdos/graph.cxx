@@ -0,0 +1,278 @@
+#include "graph.hxx"
+
+#include <fstream>
+#include <algorithm>
+#include <cstring>
+#include <climits>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+// Snapshot layout, every section padded to 8 bytes:
+//   snapshot_header
+//   int64_t offsets[n + 1]
+//   int     neighbors[offsets[n]]
+//   int64_t name_offsets[n + 1]
+//   int     name_order[n]             (version 2: ids sorted by name)
+//   char    name_pool[name_offsets[n]]
+static const char SNAPSHOT_MAGIC[8] = {'E', 'R', 'D', 'O', 'S', 'C', 'S', 'R'};
+static const uint32_t SNAPSHOT_VERSION = 2;
+
+struct snapshot_header {
+  char magic[8];
+  uint32_t version;
+  uint32_t reserved;
+  int64_t num_vertices;
+  int64_t num_neighbors;
+  int64_t pool_bytes;
+};
+
+static size_t padded(size_t bytes) {
+  return (bytes + 7) & ~size_t(7);
+}
+
+// One pass over the mapped arrays, so that nothing the traversal or the
+// name lookups index with can point outside them.
+static bool valid_sections(int64_t n, const int64_t *offsets, const int *neighbors,
+                           const int64_t *name_offsets, const int *name_order,
+                           const char *pool, int64_t pool_bytes) {
+  int64_t num_neighbors = offsets[n];
+  if(offsets[0] != 0 || name_offsets[0] != 0 || name_offsets[n] != pool_bytes){
+    return false;
+  }
+  for (int64_t v = 0; v < n; v++) {
+    // Every name holds at least its terminating NUL.
+    if(offsets[v + 1] < offsets[v] || offsets[v + 1] > num_neighbors ||
+       name_offsets[v + 1] <= name_offsets[v] || name_offsets[v + 1] > pool_bytes ||
+       pool[name_offsets[v + 1] - 1] != '\0'){
+      return false;
+    }
+  }
+  for (int64_t i = 0; i < num_neighbors; i++) {
+    if(neighbors[i] < 0 || neighbors[i] >= n){
+      return false;
+    }
+  }
+  if(name_order != NULL){
+    std::vector<char> seen(n, 0);
+    for (int64_t k = 0; k < n; k++) {
+      if(name_order[k] < 0 || name_order[k] >= n || seen[name_order[k]]){
+        return false;
+      }
+      seen[name_order[k]] = 1;
+    }
+  }
+  return true;
+}
+
+//Constructor/Destructor
+graph::graph(const std::vector<std::string> &names,
+             const std::vector<std::pair<int, int> > &edges) {
+  this->names.build(names);
+  mapping = NULL;
+  mapping_size = 0;
+  n = names.size();
+
+  // Counting pass: degree of each vertex, then prefix sums into offsets.
+  offset_storage.assign(n + 1, 0);
+  for(std::vector<std::pair<int, int> >::size_type i = 0; i != edges.size(); i++) {
+    offset_storage[edges[i].first + 1]++;
+    offset_storage[edges[i].second + 1]++;
+  }
+  for(int v = 0; v < n; v++) {
+    offset_storage[v + 1] += offset_storage[v];
+  }
+
+  // Scatter pass: each edge goes to the next free slot of both endpoints.
+  neighbor_storage.resize(offset_storage[n]);
+  std::vector<int64_t> next(offset_storage.begin(), offset_storage.end() - 1);
+  for(std::vector<std::pair<int, int> >::size_type i = 0; i != edges.size(); i++) {
+    neighbor_storage[next[edges[i].first]++] = edges[i].second;
+    neighbor_storage[next[edges[i].second]++] = edges[i].first;
+  }
+
+  offsets = offset_storage.data();
+  neighbors = neighbor_storage.data();
+}
+
+graph::graph(const graph &other, const std::vector<int> &new_id) {
+  mapping = NULL;
+  mapping_size = 0;
+  n = other.size();
+
+  std::vector<int> old_id(n);
+  for(int v = 0; v < n; v++) {
+    old_id[new_id[v]] = v;
+  }
+  names.build(other.names, new_id);
+
+  offset_storage.resize(n + 1);
+  neighbor_storage.resize(other.offsets[n]);
+  offset_storage[0] = 0;
+  for(int v = 0; v < n; v++) {
+    int old = old_id[v];
+    int64_t first = offset_storage[v];
+    offset_storage[v + 1] = first + other.degree(old);
+    int64_t k = first;
+    for(const int *it = other.begin(old); it != other.end(old); it++) {
+      neighbor_storage[k++] = new_id[*it];
+    }
+    std::sort(neighbor_storage.begin() + first, neighbor_storage.begin() + k);
+  }
+
+  offsets = offset_storage.data();
+  neighbors = neighbor_storage.data();
+}
+
+graph::graph(const std::string &snapshot_path) {
+  int fd = open(snapshot_path.c_str(), O_RDONLY);
+  if(fd < 0){
+    throw std::runtime_error("could not open " + snapshot_path);
+  }
+  struct stat st;
+  if(fstat(fd, &st) < 0 || (size_t) st.st_size < sizeof(snapshot_header)){
+    close(fd);
+    throw std::runtime_error(snapshot_path + " is too small to be a snapshot");
+  }
+  mapping_size = st.st_size;
+  mapping = mmap(NULL, mapping_size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if(mapping == MAP_FAILED){
+    mapping = NULL;
+    throw std::runtime_error("could not map " + snapshot_path);
+  }
+
+  const char *base = (const char *) mapping;
+  const snapshot_header *header = (const snapshot_header *) base;
+  // Counts larger than the file cannot be right; bounding them first
+  // keeps the section sizes below from overflowing. As with text input,
+  // there must be a person 0 for the distances to start from.
+  bool valid = std::memcmp(header->magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) == 0 &&
+               header->version >= 1 && header->version <= SNAPSHOT_VERSION &&
+               header->num_vertices >= 1 && header->num_vertices < INT_MAX &&
+               (uint64_t) header->num_vertices < mapping_size / sizeof(int64_t) &&
+               header->num_neighbors >= 0 && (uint64_t) header->num_neighbors <= mapping_size / sizeof(int) &&
+               header->pool_bytes >= 0 && (uint64_t) header->pool_bytes <= mapping_size;
+  size_t position = padded(sizeof(snapshot_header));
+  size_t vertices_bytes = 0, neighbors_bytes = 0, order_bytes = 0;
+  if(valid){
+    vertices_bytes = padded((header->num_vertices + 1) * sizeof(int64_t));
+    neighbors_bytes = padded(header->num_neighbors * sizeof(int));
+    order_bytes = header->version >= 2 ? padded(header->num_vertices * sizeof(int)) : 0;
+    valid = position + 2 * vertices_bytes + neighbors_bytes + order_bytes + header->pool_bytes <= mapping_size;
+  }
+  const int64_t *name_offsets = NULL;
+  const int *name_order = NULL;
+  if(valid){
+    offsets = (const int64_t *) (base + position);
+    position += vertices_bytes;
+    neighbors = (const int *) (base + position);
+    position += neighbors_bytes;
+    name_offsets = (const int64_t *) (base + position);
+    position += vertices_bytes;
+    name_order = order_bytes ? (const int *) (base + position) : NULL;
+    position += order_bytes;
+    valid = offsets[header->num_vertices] == header->num_neighbors &&
+            valid_sections(header->num_vertices, offsets, neighbors, name_offsets, name_order,
+                           base + position, header->pool_bytes);
+  }
+  if(!valid){
+    munmap(mapping, mapping_size);
+    mapping = NULL;
+    throw std::runtime_error(snapshot_path + " is not a valid snapshot");
+  }
+
+  n = header->num_vertices;
+  names.attach(n, name_offsets, base + position, name_order);
+}
+
+graph::~graph() {
+  if(mapping != NULL){
+    munmap(mapping, mapping_size);
+  }
+}
+
+//Snapshot
+bool graph::is_snapshot(const std::string &path) {
+  std::ifstream file(path.c_str(), std::ios::binary);
+  char magic[sizeof(SNAPSHOT_MAGIC)];
+  return file.read(magic, sizeof(magic)) &&
+         std::memcmp(magic, SNAPSHOT_MAGIC, sizeof(magic)) == 0;
+}
+
+static void write_section(std::ofstream &file, const void *data, size_t bytes) {
+  static const char zeros[8] = {0};
+  file.write((const char *) data, bytes);
+  file.write(zeros, padded(bytes) - bytes);
+}
+
+void graph::save_snapshot(const std::string &path) const {
+  snapshot_header header;
+  std::memset(&header, 0, sizeof(header));
+  std::memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+  header.version = SNAPSHOT_VERSION;
+  header.num_vertices = n;
+  header.num_neighbors = offsets[n];
+  header.pool_bytes = names.get_offsets()[n];
+
+  std::ofstream file(path.c_str(), std::ios::binary);
+  write_section(file, &header, sizeof(header));
+  write_section(file, offsets, (n + 1) * sizeof(int64_t));
+  write_section(file, neighbors, offsets[n] * sizeof(int));
+  write_section(file, names.get_offsets(), (n + 1) * sizeof(int64_t));
+  write_section(file, names.get_order(), n * sizeof(int));
+  write_section(file, names.get_pool(), header.pool_bytes);
+  if(!file){
+    throw std::runtime_error("could not write " + path);
+  }
+}
+
+//Size
+int graph::size() const {
+  return n;
+}
+
+long long graph::num_edges() const {
+  return offsets[n] / 2;
+}
+
+//Name
+const char *graph::get_name(int v) const {
+  return names.get(v);
+}
+
+int graph::find(const std::string &name) const {
+  return names.find(name);
+}
+
+const name_table &graph::get_names() const {
+  return names;
+}
+
+//Adjacency
+int graph::degree(int v) const {
+  return offsets[v + 1] - offsets[v];
+}
+
+const int *graph::begin(int v) const {
+  return neighbors + offsets[v];
+}
+
+const int *graph::end(int v) const {
+  return neighbors + offsets[v + 1];
+}
+
+//Compatibility view
+std::vector<node *> graph::make_node_view() const {
+  std::vector<node *> node_list;
+  for(int v = 0; v < size(); v++) {
+    node *nd = new node(get_name(v));
+    for(const int *it = begin(v); it != end(v); it++) {
+      nd->add_link(new class link(v, *it)); // "class": unistd.h declares link()
+    }
+    node_list.push_back(nd);
+  }
+  return node_list;
+}
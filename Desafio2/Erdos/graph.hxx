@@ -0,0 +1,64 @@
+#ifndef GRAPH_HXX
+#define GRAPH_HXX
+
+#include "node.hxx"
+#include "name_table.hxx"
+#include <vector>
+#include <string>
+#include <utility>
+#include <cstddef>
+#include <cstdint>
+
+// Compressed sparse row adjacency: the neighbors of vertex v are
+// neighbors[offsets[v] .. offsets[v+1]). Every edge is stored in both
+// directions, so the graph is undirected.
+//
+// The arrays either live in vectors owned by the graph (built from an
+// edge list) or point straight into a memory-mapped snapshot file.
+class graph {
+private:
+  std::vector<int64_t> offset_storage;
+  std::vector<int> neighbor_storage;
+
+  void *mapping;
+  size_t mapping_size;
+
+  int n;
+  const int64_t *offsets;
+  const int *neighbors;
+  name_table names;
+
+  graph(const graph &);
+  graph &operator=(const graph &);
+
+public:
+  graph(const std::vector<std::string> &names,
+        const std::vector<std::pair<int, int> > &edges);
+  // Copy of other where vertex v becomes new_id[v] (see reorder.hxx).
+  // Each adjacency list comes out sorted.
+  graph(const graph &other, const std::vector<int> &new_id);
+  // Maps a snapshot written by save_snapshot(); throws std::runtime_error.
+  graph(const std::string &snapshot_path);
+  ~graph();
+
+  static bool is_snapshot(const std::string &path);
+  void save_snapshot(const std::string &path) const;
+
+  int size() const;
+  long long num_edges() const;
+
+  const char *get_name(int v) const;
+  // Id of the author with this exact name, -1 when there is none.
+  int find(const std::string &name) const;
+  const name_table &get_names() const;
+
+  int degree(int v) const;
+  const int *begin(int v) const;
+  const int *end(int v) const;
+
+  // Builds the old node/link objects from the CSR arrays. Only meant for
+  // code that still expects them; the caller owns the returned nodes.
+  std::vector<node *> make_node_view() const;
+};
+
+#endif
@@ -10,9 +10,9 @@ link::~link(){
 }
 
 //FROM/TO
-int link::get_from(){
+int link::get_from() const {
   return from;
 }
-int link::get_to(){
+int link::get_to() const {
   return to;
 }
@@ -12,8 +12,8 @@ private:
 public:
   link(int from, int to);
   ~link();
-  int get_from();
-  int get_to();
+  int get_from() const;
+  int get_to() const;
 };
 
 #endif
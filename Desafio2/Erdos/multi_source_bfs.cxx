@@ -0,0 +1,63 @@
+#include "bfs.hxx"
+
+#include <cstdint>
+#include <algorithm>
+
+// Sources handled together: one bit of a machine word each.
+static const int BATCH = 64;
+
+// MS-BFS: every vertex carries a word whose bit i says "source i reached
+// me". One scan of the adjacency pushes all 64 searches a level forward.
+static void bfs_batch(const graph &g, const int *sources, int count,
+                      std::vector<int> *distances) {
+  int n = g.size();
+  std::vector<uint64_t> seen(n, 0);
+  std::vector<uint64_t> visit(n, 0);
+  std::vector<uint64_t> visit_next(n, 0);
+
+  for (int i = 0; i < count; i++) {
+    uint64_t bit = uint64_t(1) << i;
+    seen[sources[i]] |= bit;
+    visit[sources[i]] |= bit;
+    distances[i][sources[i]] = 0;
+  }
+
+  int level = 0;
+  bool active = true;
+  while (active) {
+    active = false;
+    for (int v = 0; v < n; v++) {
+      uint64_t bits = visit[v];
+      if(bits == 0){
+        continue;
+      }
+      for(const int *it = g.begin(v); it != g.end(v); it++) {
+        visit_next[*it] |= bits;
+      }
+    }
+    level++;
+    for (int v = 0; v < n; v++) {
+      uint64_t fresh = visit_next[v] & ~seen[v];
+      visit_next[v] = 0;
+      visit[v] = fresh;
+      if(fresh == 0){
+        continue;
+      }
+      active = true;
+      seen[v] |= fresh;
+      while (fresh) {
+        distances[__builtin_ctzll(fresh)][v] = level;
+        fresh &= fresh - 1;
+      }
+    }
+  }
+}
+
+void bfs_multi_source(const graph &g, const std::vector<int> &sources,
+                      std::vector<std::vector<int> > &distances) {
+  distances.assign(sources.size(), std::vector<int>(g.size(), -1));
+  for(std::vector<int>::size_type first = 0; first < sources.size(); first += BATCH) {
+    int count = std::min<std::vector<int>::size_type>(BATCH, sources.size() - first);
+    bfs_batch(g, &sources[first], count, &distances[first]);
+  }
+}
@@ -0,0 +1,135 @@
+#include "name_table.hxx"
+
+#include <algorithm>
+#include <cstring>
+
+// Orders ids by the bytes of their names.
+struct name_less {
+  const int64_t *offsets;
+  const char *pool;
+
+  bool operator()(int a, int b) const {
+    return std::strcmp(pool + offsets[a], pool + offsets[b]) < 0;
+  }
+};
+
+//Constructor/Destructor
+name_table::name_table() {
+  n = 0;
+  offset_storage.assign(1, 0);
+  offsets = offset_storage.data();
+  pool = NULL;
+  order = NULL;
+}
+
+name_table::~name_table() {
+}
+
+//Building
+void name_table::sort_order() {
+  order_storage.resize(n);
+  for (int id = 0; id < n; id++) {
+    order_storage[id] = id;
+  }
+  name_less less = {offsets, pool};
+  std::stable_sort(order_storage.begin(), order_storage.end(), less);
+  order = order_storage.data();
+}
+
+void name_table::build(const std::vector<std::string> &names) {
+  n = names.size();
+  size_t bytes = 0;
+  for (int id = 0; id < n; id++) {
+    bytes += names[id].size() + 1;
+  }
+  pool_storage.clear();
+  pool_storage.reserve(bytes);
+  offset_storage.resize(n + 1);
+  for (int id = 0; id < n; id++) {
+    offset_storage[id] = pool_storage.size();
+    pool_storage.insert(pool_storage.end(), names[id].begin(), names[id].end());
+    pool_storage.push_back('\0');
+  }
+  offset_storage[n] = pool_storage.size();
+  offsets = offset_storage.data();
+  pool = pool_storage.data();
+  sort_order();
+}
+
+void name_table::build(const name_table &other, const std::vector<int> &new_id) {
+  n = other.size();
+  std::vector<int> old_id(n);
+  for (int id = 0; id < n; id++) {
+    old_id[new_id[id]] = id;
+  }
+  pool_storage.resize(other.offsets[n]);
+  offset_storage.resize(n + 1);
+  int64_t position = 0;
+  for (int id = 0; id < n; id++) {
+    int64_t bytes = other.length(old_id[id]) + 1;
+    offset_storage[id] = position;
+    std::memcpy(&pool_storage[position], other.get(old_id[id]), bytes);
+    position += bytes;
+  }
+  offset_storage[n] = position;
+  order_storage.resize(n);
+  for (int k = 0; k < n; k++) {
+    order_storage[k] = new_id[other.order[k]];
+  }
+  offsets = offset_storage.data();
+  pool = pool_storage.data();
+  order = order_storage.data();
+}
+
+void name_table::attach(int n, const int64_t *offsets, const char *pool, const int *order) {
+  this->n = n;
+  this->offsets = offsets;
+  this->pool = pool;
+  this->order = order;
+  if(order == NULL){
+    sort_order();
+  }
+}
+
+//Lookup
+int name_table::size() const {
+  return n;
+}
+
+const char *name_table::get(int id) const {
+  return pool + offsets[id];
+}
+
+int name_table::length(int id) const {
+  return offsets[id + 1] - offsets[id] - 1;
+}
+
+int name_table::find(const std::string &name) const {
+  int low = 0;
+  int high = n;
+  while (low < high) {
+    int middle = low + (high - low) / 2;
+    if(std::strcmp(get(order[middle]), name.c_str()) < 0){
+      low = middle + 1;
+    }else{
+      high = middle;
+    }
+  }
+  if(low < n && name == get(order[low])){
+    return order[low];
+  }
+  return -1;
+}
+
+//Raw arrays
+const int64_t *name_table::get_offsets() const {
+  return offsets;
+}
+
+const char *name_table::get_pool() const {
+  return pool;
+}
+
+const int *name_table::get_order() const {
+  return order;
+}
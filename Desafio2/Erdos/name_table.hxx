@@ -0,0 +1,48 @@
+#ifndef NAME_TABLE_HXX
+#define NAME_TABLE_HXX
+
+#include <vector>
+#include <string>
+#include <cstdint>
+
+// Every author name lives once in a single NUL-terminated character pool;
+// ids index into it. A permutation of the ids sorted by name answers
+// name -> id lookups by binary search. Like graph, the arrays are either
+// owned or point into a mapped snapshot.
+class name_table {
+private:
+  std::vector<int64_t> offset_storage;
+  std::vector<char> pool_storage;
+  std::vector<int> order_storage;
+
+  int n;
+  const int64_t *offsets;
+  const char *pool;
+  const int *order;
+
+  void sort_order();
+
+public:
+  name_table();
+  ~name_table();
+
+  void build(const std::vector<std::string> &names);
+  // Copy of other where name id becomes new_id[id]; reuses its sort order.
+  void build(const name_table &other, const std::vector<int> &new_id);
+  // Views arrays owned by someone else. Without a sorted order (older
+  // snapshots) one is computed here.
+  void attach(int n, const int64_t *offsets, const char *pool, const int *order);
+
+  int size() const;
+  const char *get(int id) const;
+  int length(int id) const;
+
+  // Id of the author with exactly this name, -1 when there is none.
+  int find(const std::string &name) const;
+
+  const int64_t *get_offsets() const;
+  const char *get_pool() const;
+  const int *get_order() const;
+};
+
+#endif
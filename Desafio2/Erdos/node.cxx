@@ -13,7 +13,7 @@ node::~node() {
 }
 
 //Distance
-int node::get_distance(){
+int node::get_distance() const {
   return distance;
 }
 
@@ -22,12 +22,12 @@ void node::set_distance(int distance){
 }
 
 //Name
-std::string node::get_name(){
+const std::string &node::get_name() const {
   return name;
 }
 
 //Visited
-bool node::was_visited() {
+bool node::was_visited() const {
   return visited;
 }
 
@@ -40,6 +40,6 @@ void node::add_link(link *connection){
   link_list.push_back(connection);
 }
 
-std::vector<link *> node::get_links() {
+const std::vector<link *> &node::get_links() const {
   return link_list;
 }
@@ -16,15 +16,15 @@ public:
   node(std::string name);
   ~node();
 
-  std::string get_name();
+  const std::string &get_name() const;
 
-  int get_distance();
+  int get_distance() const;
   void set_distance(int distance);
 
   void add_link(link *connection);
-  std::vector<link*> get_links();
+  const std::vector<link*> &get_links() const;
 
-  bool was_visited();
+  bool was_visited() const;
   void make_a_visit();
 };
 
@@ -0,0 +1,76 @@
+#include "pair_query.hxx"
+
+#include <climits>
+
+//Constructor/Destructor
+pair_query::pair_query(const graph &g) {
+  this->g = &g;
+  generation = 0;
+  for (int side = 0; side < 2; side++) {
+    stamp[side].assign(g.size(), 0);
+    distance[side].resize(g.size());
+  }
+}
+
+pair_query::~pair_query() {
+}
+
+//Search
+// Pushes one side forward by a whole level. Returns the shortest path
+// through an edge that reaches the other side, or INT_MAX if none did.
+int pair_query::expand(int side) {
+  int other = 1 - side;
+  int best = INT_MAX;
+  long long next_work = 0;
+  next.clear();
+  for(std::vector<int>::size_type i = 0; i != frontier[side].size(); i++) {
+    int v = frontier[side][i];
+    int next_distance = distance[side][v] + 1;
+    for(const int *it = g->begin(v); it != g->end(v); it++) {
+      int w = *it;
+      if(stamp[other][w] == generation){
+        int length = next_distance + distance[other][w];
+        if(length < best){
+          best = length;
+        }
+      }
+      if(stamp[side][w] != generation){
+        stamp[side][w] = generation;
+        distance[side][w] = next_distance;
+        next.push_back(w);
+        next_work += g->degree(w);
+      }
+    }
+  }
+  frontier[side].swap(next);
+  work[side] = next_work;
+  return best;
+}
+
+int pair_query::distance_between(int from, int to) {
+  if(from == to){
+    return 0;
+  }
+  if(++generation == 0){
+    // The stamps wrapped around: this is the only time they are cleared.
+    for (int side = 0; side < 2; side++) {
+      stamp[side].assign(g->size(), 0);
+    }
+    generation = 1;
+  }
+  int ends[2] = {from, to};
+  for (int side = 0; side < 2; side++) {
+    stamp[side][ends[side]] = generation;
+    distance[side][ends[side]] = 0;
+    frontier[side].assign(1, ends[side]);
+    work[side] = g->degree(ends[side]);
+  }
+  while (!frontier[0].empty() && !frontier[1].empty()) {
+    // Grow the side that has less adjacency to scan.
+    int best = expand(work[0] <= work[1] ? 0 : 1);
+    if(best != INT_MAX){
+      return best;
+    }
+  }
+  return -1;
+}
@@ -0,0 +1,30 @@
+#ifndef PAIR_QUERY_HXX
+#define PAIR_QUERY_HXX
+
+#include "graph.hxx"
+#include <vector>
+
+// Answers "how far apart are these two authors?" with a bidirectional BFS.
+// Visited marks are generation stamps, so the arrays are allocated once
+// and never cleared between queries.
+class pair_query {
+private:
+  const graph *g;
+  unsigned generation;
+  std::vector<unsigned> stamp[2];
+  std::vector<int> distance[2];
+  std::vector<int> frontier[2];
+  long long work[2]; // adjacency entries a frontier would scan
+  std::vector<int> next;
+
+  int expand(int side);
+
+public:
+  pair_query(const graph &g);
+  ~pair_query();
+
+  // Length of a shortest path, -1 when the authors are not connected.
+  int distance_between(int from, int to);
+};
+
+#endif
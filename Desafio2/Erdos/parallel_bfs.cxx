@@ -0,0 +1,128 @@
+#include "bfs.hxx"
+#include "barrier.hxx"
+
+#include <atomic>
+#include <thread>
+#include <algorithm>
+
+// Frontier vertices are handed out in chunks of this size; small enough
+// to balance hubs, big enough to keep the cursor off the hot path.
+static const int CHUNK = 64;
+
+// State shared by every worker of one traversal.
+struct parallel_state {
+  const graph *g;
+  int num_threads;
+  std::atomic<int> *distance;
+  std::vector<int> frontier;
+  std::vector<int> next;
+  int frontier_size;
+  int level;
+  bool done;
+  // Each thread owns the slice [cursor, end) of the frontier and steals
+  // from the other slices once its own runs dry.
+  std::vector<std::atomic<int> > cursor;
+  std::vector<int> end;
+  std::vector<std::vector<int> > local_next;
+  std::vector<int> copy_offset;
+  barrier sync;
+
+  parallel_state(const graph &g, int num_threads)
+    : g(&g), num_threads(num_threads), distance(new std::atomic<int>[g.size()]),
+      frontier(g.size()), next(g.size()), frontier_size(0), level(0), done(false),
+      cursor(num_threads), end(num_threads), local_next(num_threads),
+      copy_offset(num_threads), sync(num_threads) {}
+  ~parallel_state() {
+    delete[] distance;
+  }
+
+  void partition() {
+    for (int t = 0; t < num_threads; t++) {
+      cursor[t].store((long long) frontier_size * t / num_threads);
+      end[t] = (long long) frontier_size * (t + 1) / num_threads;
+    }
+  }
+};
+
+static void expand(parallel_state &s, int first, int last, std::vector<int> &out) {
+  int next_distance = s.level + 1;
+  for (int i = first; i < last; i++) {
+    int v = s.frontier[i];
+    for(const int *it = s.g->begin(v); it != s.g->end(v); it++) {
+      int expected = -1;
+      if(s.distance[*it].load(std::memory_order_relaxed) == -1 &&
+         s.distance[*it].compare_exchange_strong(expected, next_distance,
+                                                 std::memory_order_relaxed)){
+        out.push_back(*it);
+      }
+    }
+  }
+}
+
+static void worker(parallel_state &s, int t) {
+  while (true) {
+    // Own slice first, then steal from the others in round-robin order.
+    for (int k = 0; k < s.num_threads; k++) {
+      int victim = (t + k) % s.num_threads;
+      int first;
+      while ((first = s.cursor[victim].fetch_add(CHUNK)) < s.end[victim]) {
+        expand(s, first, std::min(first + CHUNK, s.end[victim]), s.local_next[t]);
+      }
+    }
+    s.sync.wait();
+
+    if(t == 0){
+      int total = 0;
+      for (int i = 0; i < s.num_threads; i++) {
+        s.copy_offset[i] = total;
+        total += s.local_next[i].size();
+      }
+      s.frontier_size = total;
+      s.done = total == 0;
+    }
+    s.sync.wait();
+    if(s.done){
+      return;
+    }
+
+    std::copy(s.local_next[t].begin(), s.local_next[t].end(),
+              s.next.begin() + s.copy_offset[t]);
+    s.local_next[t].clear();
+    s.sync.wait();
+
+    if(t == 0){
+      s.frontier.swap(s.next);
+      s.level++;
+      s.partition();
+    }
+    s.sync.wait();
+  }
+}
+
+void bfs_parallel(const graph &g, int source, std::vector<int> &distance, int num_threads) {
+  if(num_threads < 1){
+    num_threads = 1;
+  }
+  parallel_state s(g, num_threads);
+  for (int v = 0; v < g.size(); v++) {
+    s.distance[v].store(-1, std::memory_order_relaxed);
+  }
+  s.distance[source].store(0, std::memory_order_relaxed);
+  s.frontier[0] = source;
+  s.frontier_size = 1;
+  s.partition();
+
+  std::vector<std::thread> threads;
+  for (int t = 1; t < num_threads; t++) {
+    threads.push_back(std::thread(worker, std::ref(s), t));
+  }
+  worker(s, 0);
+  for(std::vector<std::thread>::size_type i = 0; i != threads.size(); i++) {
+    threads[i].join();
+  }
+
+  distance.resize(g.size());
+  for (int v = 0; v < g.size(); v++) {
+    distance[v] = s.distance[v].load(std::memory_order_relaxed);
+  }
+}
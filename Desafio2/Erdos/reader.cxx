@@ -0,0 +1,53 @@
+#include "reader.hxx"
+
+#include "tokenizer.hxx"
+
+#include <vector>
+#include <climits>
+#include <utility>
+#include <stdexcept>
+
+static graph *read_text_graph(const std::string &path) {
+  tokenizer file(path);
+  std::vector<std::string> names; // one name per person
+  std::vector<std::pair<int, int> > edges; // list of connections
+
+  long long n = file.read_int(); // number of people
+  if(n < 0 || n > INT_MAX){
+    file.fail("invalid number of people");
+  }
+  if(n == 0){
+    // Distances are measured from person 0, so there must be one.
+    file.fail("no people: person 0 is the source of every distance");
+  }
+  file.expect_end_of_line();
+  names.resize(n);
+  for (int i = 0; i < n; i++) {
+    if(!file.read_line(names[i])){
+      file.fail("expected a name, found end of input");
+    }
+  }
+  long long m = file.read_int(); // number of connections
+  if(m < 0){
+    file.fail("invalid number of connections");
+  }
+  file.expect_end_of_line();
+  edges.reserve(m);
+  for (long long i = 0; i < m; i++) {
+    long long from = file.read_int();
+    long long to = file.read_int();
+    if(from < 0 || from >= n || to < 0 || to >= n){
+      file.fail("connection refers to an unknown person");
+    }
+    file.expect_end_of_line();
+    edges.push_back(std::make_pair((int) from, (int) to));
+  }
+  return new graph(names, edges);
+}
+
+graph *read_graph(const std::string &path) {
+  if(graph::is_snapshot(path)){
+    return new graph(path);
+  }
+  return read_text_graph(path);
+}
@@ -0,0 +1,12 @@
+#ifndef READER_HXX
+#define READER_HXX
+
+#include "graph.hxx"
+#include <string>
+
+// Loads either a binary snapshot (mapped, no parsing) or the text format:
+// the number of people, one name per line, the number of connections and
+// one "from to" pair per line. Throws std::runtime_error on failure.
+graph *read_graph(const std::string &path);
+
+#endif
@@ -0,0 +1,98 @@
+#include "reorder.hxx"
+
+#include <algorithm>
+#include <stdexcept>
+
+struct by_degree {
+  const graph *g;
+
+  bool operator()(int a, int b) const {
+    return g->degree(a) < g->degree(b);
+  }
+};
+
+// Appends the BFS discovery order of every component to order, starting
+// each component at the first unplaced vertex of roots. With sorted set,
+// the neighbors of each vertex are visited by increasing degree.
+static void bfs_order(const graph &g, const std::vector<int> &roots, bool sorted,
+                      std::vector<int> &order) {
+  std::vector<char> placed(g.size(), 0);
+  std::vector<int> children;
+  by_degree less = {&g};
+  order.clear();
+  order.reserve(g.size());
+  for(std::vector<int>::size_type r = 0; r != roots.size(); r++) {
+    if(placed[roots[r]]){
+      continue;
+    }
+    std::vector<int>::size_type head = order.size();
+    order.push_back(roots[r]);
+    placed[roots[r]] = 1;
+    for(; head != order.size(); head++) {
+      int v = order[head];
+      children.clear();
+      for(const int *it = g.begin(v); it != g.end(v); it++) {
+        if(!placed[*it]){
+          placed[*it] = 1;
+          children.push_back(*it);
+        }
+      }
+      if(sorted){
+        std::stable_sort(children.begin(), children.end(), less);
+      }
+      order.insert(order.end(), children.begin(), children.end());
+    }
+  }
+}
+
+static std::vector<int> invert(const std::vector<int> &order) {
+  std::vector<int> new_id(order.size());
+  for(std::vector<int>::size_type i = 0; i != order.size(); i++) {
+    new_id[order[i]] = i;
+  }
+  return new_id;
+}
+
+std::vector<int> reorder_rcm(const graph &g) {
+  std::vector<int> roots(g.size());
+  for (int v = 0; v < g.size(); v++) {
+    roots[v] = v;
+  }
+  by_degree less = {&g};
+  std::stable_sort(roots.begin(), roots.end(), less);
+  std::vector<int> order;
+  bfs_order(g, roots, true, order);
+  std::reverse(order.begin(), order.end());
+  return invert(order);
+}
+
+std::vector<int> reorder_bfs(const graph &g) {
+  std::vector<int> roots(g.size());
+  for (int v = 0; v < g.size(); v++) {
+    roots[v] = v;
+  }
+  std::vector<int> order;
+  bfs_order(g, roots, false, order);
+  return invert(order);
+}
+
+std::vector<int> reorder_degree(const graph &g) {
+  std::vector<int> order(g.size());
+  for (int v = 0; v < g.size(); v++) {
+    order[v] = v;
+  }
+  std::stable_sort(order.begin(), order.end(),
+                   [&g](int a, int b) { return g.degree(a) > g.degree(b); });
+  return invert(order);
+}
+
+std::vector<int> reorder(const graph &g, const std::string &method) {
+  if(method == "rcm"){
+    return reorder_rcm(g);
+  }else if(method == "bfs"){
+    return reorder_bfs(g);
+  }else if(method == "degree"){
+    return reorder_degree(g);
+  }
+  throw std::runtime_error("unknown reordering " + method);
+}
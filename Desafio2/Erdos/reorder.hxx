@@ -0,0 +1,23 @@
+#ifndef REORDER_HXX
+#define REORDER_HXX
+
+#include "graph.hxx"
+#include <vector>
+#include <string>
+
+// Vertex renumberings that put neighbors close together in memory. Each
+// returns new_id, where new_id[v] is the position of old vertex v; pass it
+// to the relabeling graph constructor.
+
+// Reverse Cuthill-McKee: BFS from a low-degree vertex of each component,
+// visiting neighbors by increasing degree, then reversed.
+std::vector<int> reorder_rcm(const graph &g);
+// Plain BFS discovery order from vertex 0 (then any unreached component).
+std::vector<int> reorder_bfs(const graph &g);
+// Highest degree first, so the hubs share cache lines.
+std::vector<int> reorder_degree(const graph &g);
+
+// "rcm", "bfs" or "degree"; throws std::runtime_error for anything else.
+std::vector<int> reorder(const graph &g, const std::string &method);
+
+#endif
@@ -0,0 +1,196 @@
+#include "tokenizer.hxx"
+
+#include <sstream>
+#include <cstring>
+#include <climits>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+
+static const size_t BLOCK_SIZE = 1 << 20;
+
+//Constructor/Destructor
+tokenizer::tokenizer(const std::string &path)
+  : buffer(BLOCK_SIZE) {
+  fd = open(path.c_str(), O_RDONLY);
+  if(fd < 0){
+    throw std::runtime_error("could not open " + path);
+  }
+  owns_fd = true;
+  source = path;
+  pos = 0;
+  end = 0;
+  eof = false;
+  line_number = 1;
+}
+
+tokenizer::tokenizer(int fd, const std::string &source)
+  : buffer(BLOCK_SIZE) {
+  this->fd = fd;
+  owns_fd = false;
+  this->source = source;
+  pos = 0;
+  end = 0;
+  eof = false;
+  line_number = 1;
+}
+
+tokenizer::~tokenizer() {
+  if(owns_fd){
+    close(fd);
+  }
+}
+
+//Buffer
+// Reads the next block once the current one is used up.
+bool tokenizer::fill() {
+  if(eof){
+    return false;
+  }
+  pos = 0;
+  end = 0;
+  ssize_t got;
+  do {
+    got = read(fd, buffer.data(), buffer.size());
+  } while (got < 0 && errno == EINTR);
+  if(got <= 0){
+    eof = true;
+    return false;
+  }
+  end = got;
+  return true;
+}
+
+//Errors
+long tokenizer::line() const {
+  return line_number;
+}
+
+void tokenizer::fail(const std::string &message) const {
+  std::ostringstream oss;
+  oss << source << ':' << line_number << ": " << message;
+  throw parse_error(oss.str());
+}
+
+//Whitespace
+void tokenizer::skip_blanks() {
+  int c;
+  while ((c = peek()) == ' ' || c == '\t' || c == '\r') {
+    pos++;
+  }
+}
+
+void tokenizer::skip_whitespace() {
+  int c;
+  while ((c = peek()) == ' ' || c == '\t' || c == '\r' || c == '\n') {
+    if(c == '\n'){
+      line_number++;
+    }
+    pos++;
+  }
+}
+
+bool tokenizer::at_end() {
+  skip_whitespace();
+  return peek() == -1;
+}
+
+//Tokens
+long long tokenizer::read_int() {
+  skip_whitespace();
+  bool negative = false;
+  int c = peek();
+  if(c == '-' || c == '+'){
+    negative = c == '-';
+    pos++;
+    c = peek();
+  }
+  if(c < '0' || c > '9'){
+    fail(c == -1 ? "expected an integer, found end of input" : "expected an integer");
+  }
+  long long value = 0;
+  while (c >= '0' && c <= '9') {
+    if(value > (LLONG_MAX - (c - '0')) / 10){
+      fail("integer out of range");
+    }
+    value = value * 10 + (c - '0');
+    pos++;
+    c = peek();
+  }
+  return negative ? -value : value;
+}
+
+int tokenizer::read_bit() {
+  long long value = read_int();
+  if(value != 0 && value != 1){
+    fail("expected 0 or 1");
+  }
+  return value;
+}
+
+char tokenizer::read_char() {
+  skip_whitespace();
+  int c = peek();
+  if(c == -1){
+    fail("unexpected end of input");
+  }
+  pos++;
+  return c;
+}
+
+void tokenizer::read_word(std::string &word) {
+  skip_whitespace();
+  word.clear();
+  int c = peek();
+  if(c == -1){
+    fail("unexpected end of input");
+  }
+  while (c != -1 && c != ' ' && c != '\t' && c != '\r' && c != '\n') {
+    // Copy the whole run that is already in the buffer at once.
+    size_t stop = pos;
+    while (stop < end && buffer[stop] != ' ' && buffer[stop] != '\t' &&
+           buffer[stop] != '\r' && buffer[stop] != '\n') {
+      stop++;
+    }
+    word.append(buffer.data() + pos, stop - pos);
+    pos = stop;
+    c = peek();
+  }
+}
+
+bool tokenizer::read_line(std::string &line) {
+  line.clear();
+  if(peek() == -1){
+    return false;
+  }
+  while (true) {
+    const char *start = buffer.data() + pos;
+    const char *newline = (const char *) std::memchr(start, '\n', end - pos);
+    if(newline != NULL){
+      line.append(start, newline - start);
+      pos += newline - start + 1;
+      line_number++;
+      break;
+    }
+    line.append(start, end - pos);
+    pos = end;
+    if(!fill()){
+      break;
+    }
+  }
+  if(!line.empty() && line[line.size() - 1] == '\r'){
+    line.erase(line.size() - 1);
+  }
+  return true;
+}
+
+void tokenizer::expect_end_of_line() {
+  skip_blanks();
+  int c = peek();
+  if(c == '\n'){
+    pos++;
+    line_number++;
+  }else if(c != -1){
+    fail(std::string("unexpected '") + (char) c + "' at end of line");
+  }
+}
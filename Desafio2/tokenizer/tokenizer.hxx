@@ -0,0 +1,71 @@
+#ifndef TOKENIZER_HXX
+#define TOKENIZER_HXX
+
+#include <string>
+#include <vector>
+#include <stdexcept>
+
+// Thrown for malformed input; the message starts with "source:line:".
+class parse_error : public std::runtime_error {
+public:
+  parse_error(const std::string &message) : std::runtime_error(message) {}
+};
+
+// Reads a file (or any descriptor, e.g. stdin) in large blocks and hands
+// out integers, words and lines without going through iostreams. Words and
+// lines are written into caller-owned strings so a loop can reuse them.
+// "\r\n" line endings are accepted everywhere.
+class tokenizer {
+private:
+  int fd;
+  bool owns_fd;
+  std::string source;
+  std::vector<char> buffer;
+  size_t pos;
+  size_t end;
+  bool eof;
+  long line_number;
+
+  bool fill();
+
+  // Next byte without consuming it, or -1 at end of input.
+  int peek() {
+    if(pos == end && !fill()){
+      return -1;
+    }
+    return (unsigned char) buffer[pos];
+  }
+
+  void skip_blanks();
+  void skip_whitespace();
+
+  tokenizer(const tokenizer &);
+  tokenizer &operator=(const tokenizer &);
+
+public:
+  // Throws std::runtime_error when the file cannot be opened.
+  tokenizer(const std::string &path);
+  tokenizer(int fd, const std::string &source);
+  ~tokenizer();
+
+  long line() const;
+  void fail(const std::string &message) const;
+
+  // True when only whitespace is left.
+  bool at_end();
+
+  // Skip any whitespace (newlines included) before the token.
+  long long read_int();
+  // An integer that must be 0 or 1.
+  int read_bit();
+  char read_char();
+  void read_word(std::string &word);
+
+  // Rest of the current line, without the line terminator. Returns false
+  // at end of input.
+  bool read_line(std::string &line);
+  // Only blanks may remain on the current line; consumes the newline.
+  void expect_end_of_line();
+};
+
+#endif